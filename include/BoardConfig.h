@@ -1,8 +1,8 @@
 /**
  * @file BoardConfig.h
  * @author Planeson, Red Bird Racing
- * @date 2026-01-15
- * @version 2.0.1
+ * @date 2026-10-16
+ * @version 2.1.1
  * @brief Board configuration for the VCU (Vehicle Control Unit)
  * @details This file defines the board configuration and pin mappings for different versions of the VCU and for Arduino Uno.
  * Define the appropriate macro to select the desired board configuration.
@@ -16,6 +16,8 @@
  * - Undefined: no pins defined, intentional compilation error
  *
  * @note Only one option should be uncommented at a time.
+ * @note INT_CAN_MOTOR, INT_CAN_BMS and INT_CAN_DL are the MCP2515 INT lines, only define the ones wired to the MCU, see CanInterrupt.hpp.
+ * None of the boards below wires them yet.
  */
 
 #ifndef BOARDCONFIG_H
@@ -37,6 +39,8 @@
 #define CS_CAN_DL PIN_PD1 // CAN 3
 #define CS_CAN_BMS PIN_PB2   // CAN 2
 #define CS_CAN_MOTOR PIN_PB1    // CAN 1
+// MCP2515 INT lines: not wired to the MCU on this board, RX is polled every tick
+// define INT_CAN_DL, INT_CAN_BMS and INT_CAN_MOTOR here once a revision routes them, on one port other than HALL_SENSOR's
 
 // === APPS and Brake pins ===
 #define APPS_5V PIN_A6
@@ -2,8 +2,8 @@
  * @file CarState.hpp
  * @author Planeson, Red Bird Racing
  * @brief Definition of the CarState structure representing the state of the car
- * @version 1.4.1
- * @date 2026-02-09
+ * @version 1.11.0
+ * @date 2026-10-16
  * @see can.h, Enums.h
  */
 
@@ -11,22 +11,32 @@
 #define CAR_STATE_HPP
 
 #include "Enums.hpp"
+#include "Curves.hpp" // ADC_BITS
 #include <can.h>
 #include <stdint.h>
 
-constexpr canid_t TELEMETRY_PEDAL_MSG = 0x700; /**< Telemetry: Pedal readings message */
-constexpr canid_t TELEMETRY_MOTOR_MSG = 0x701; /**< Telemetry: Digital signals message */
-constexpr canid_t TELEMETRY_BMS_MSG = 0x710;   /**< Telemetry: Car state message */
+constexpr canid_t TELEMETRY_PEDAL_MSG = 0x700;      /**< Telemetry: Pedal readings message */
+constexpr canid_t TELEMETRY_MOTOR_MSG = 0x701;      /**< Telemetry: Digital signals message */
+constexpr canid_t TELEMETRY_SCHEDULER_MSG = 0x702;  /**< Telemetry: scheduler timing with SCHEDULER_STATS, one task or the tick per frame, see SchedulerStats */
+constexpr canid_t TELEMETRY_BMS_MSG = 0x710;        /**< Telemetry: Car state message */
+constexpr canid_t TELEMETRY_CAN_MSG = 0x703;        /**< Telemetry: CAN receive buffer overflows per bus */
+constexpr canid_t TELEMETRY_CAN_TX_MSG = 0x704;     /**< Telemetry: CAN transmit queue drops per bus and coalesced frames */
+constexpr canid_t TELEMETRY_SCHED_LOAD_MSG = 0x705; /**< Telemetry: scheduler load shedding, deferred and dropped tasks */
+
+constexpr uint8_t TELEMETRY_CAN_BUSES = 3; /**< Buses counted in TELEMETRY_CAN_MSG, one per McpIndex */
+
+constexpr uint8_t TELEMETRY_ADC_BITS = 12; /**< Width of the APPS and brake fields in TELEMETRY_PEDAL_MSG, readings are scaled up to it */
+static_assert(ADC_BITS <= TELEMETRY_ADC_BITS, "APPS and brake readings must fit the telemetry fields, lower ADC_OVERSAMPLE_BITS");
 
 /**
  * @brief Telemetry frame structure for the Pedals.
  */
 struct TelemetryFramePedal
 {
-    uint16_t apps_5v;  /**< ADC reading for 5V APPS */
-    uint16_t apps_3v3; /**< ADC reading for 3.3V APPS */
-    uint16_t brake;       /**< ADC reading for brake pedal */
-    uint16_t hall_sensor; /**< ADC reading for hall sensor */
+    uint16_t apps_5v;     /**< ADC reading for 5V APPS, ADC_BITS */
+    uint16_t apps_3v3;    /**< ADC reading for 3.3V APPS, ADC_BITS */
+    uint16_t brake;       /**< ADC reading for brake pedal, ADC_BITS */
+    uint16_t wheel_rpm;   /**< Wheel RPM from the hall sensor */
 
     /** @brief Union of bits for car status besides Pedal */
     union StateByteStatus
@@ -67,26 +77,49 @@ struct TelemetryFramePedal
     static_assert(sizeof(StateByteStatus) == 1, "TelemetryStateByte0 must be 1 byte"); // ensure compile is shoving the bits as expected
     static_assert(sizeof(StateByteFaults) == 1, "TelemetryStateByte1 must be 1 byte");
 
-    StateByteStatus status; /**< Car Status */
-    StateByteFaults faults; /**< Pedal Faults */
+    StateByteStatus status;         /**< Car Status */
+    StateByteFaults faults;         /**< Pedal Faults */
+    TorqueProfileId torque_profile; /**< Torque profile in use by Pedal::sendFrame */
 
     /**
      * @brief Converts the TelemetryFramePedal to a CAN frame.
+     * @details Little-endian bit fields: apps_5v [0:11], apps_3v3 [12:23], brake [24:35] as 12-bit,
+     * wheel_rpm [36:45] in 2 RPM steps saturated at 2046 RPM, torque_profile [46:47], status byte 6, faults byte 7.
      * @return CAN frame representing the Pedal telemetry signals.
      */
     constexpr can_frame toCanFrame() const
     {
         return can_frame{
-            TELEMETRY_PEDAL_MSG,               // can_id
-            8,                                 // can_dlc
-            static_cast<__u8>(apps_5v & 0xFF), // data
-            static_cast<__u8>(((apps_5v >> 8) & 0x03) | ((apps_3v3 & 0x3F) << 2)),
-            static_cast<__u8>(((apps_3v3 >> 6) & 0x0F) | ((brake & 0x0F) << 4)),
-            static_cast<__u8>(((brake >> 4) & 0x3F) | ((hall_sensor & 0x03) << 6)),
-            static_cast<__u8>((hall_sensor >> 2) & 0xFF),
+            TELEMETRY_PEDAL_MSG, // can_id
+            8,                   // can_dlc
+            static_cast<__u8>(field(apps_5v) & 0xFF), // data
+            static_cast<__u8>(((field(apps_5v) >> 8) & 0x0F) | ((field(apps_3v3) & 0x0F) << 4)),
+            static_cast<__u8>((field(apps_3v3) >> 4) & 0xFF),
+            static_cast<__u8>(field(brake) & 0xFF),
+            static_cast<__u8>(((field(brake) >> 8) & 0x0F) | ((rpmField() & 0x0F) << 4)),
+            static_cast<__u8>(((rpmField() >> 4) & 0x3F) | ((static_cast<uint8_t>(torque_profile) & 0x03) << 6)),
             status.byte,
-            faults.byte,
-            0x00};
+            faults.byte};
+    }
+
+private:
+    /**
+     * @brief Scales an APPS or brake reading to TELEMETRY_ADC_BITS, so the frame layout doesn't depend on ADC_OVERSAMPLE_BITS.
+     * @param reading Reading in ADC_BITS
+     * @return Reading in TELEMETRY_ADC_BITS
+     */
+    static constexpr uint16_t field(const uint16_t reading)
+    {
+        return static_cast<uint16_t>(reading << (TELEMETRY_ADC_BITS - ADC_BITS));
+    }
+
+    /**
+     * @brief Scales wheel_rpm to its 10-bit field, 2 RPM per step, enough for ~190km/h on 13 inch wheels.
+     * @return wheel_rpm / 2, saturated at 0x3FF
+     */
+    constexpr uint16_t rpmField() const
+    {
+        return wheel_rpm / 2 > 0x3FF ? 0x3FF : wheel_rpm / 2;
     }
 };
 
@@ -148,18 +181,98 @@ struct TelemetryFrameBms
     }
 };
 
+/**
+ * @brief Telemetry frame structure for the CAN controllers.
+ */
+struct TelemetryFrameCan
+{
+    uint16_t rx_overruns[TELEMETRY_CAN_BUSES]; /**< Frames lost to MCP2515 receive buffer overflows, per bus in McpIndex order, saturating */
+
+    /**
+     * @brief Converts the TelemetryFrameCan to a CAN frame.
+     * @return CAN frame with the overflow counts of the motor, BMS and datalogger buses, little endian.
+     */
+    constexpr can_frame toCanFrame() const
+    {
+        return can_frame{
+            TELEMETRY_CAN_MSG, // can_id
+            6,                 // can_dlc
+            static_cast<__u8>(rx_overruns[0] & 0xFF),
+            static_cast<__u8>((rx_overruns[0] >> 8) & 0xFF),
+            static_cast<__u8>(rx_overruns[1] & 0xFF),
+            static_cast<__u8>((rx_overruns[1] >> 8) & 0xFF),
+            static_cast<__u8>(rx_overruns[2] & 0xFF),
+            static_cast<__u8>((rx_overruns[2] >> 8) & 0xFF)};
+    }
+};
+
+/**
+ * @brief Telemetry frame structure for the CAN transmit queues.
+ */
+struct TelemetryFrameCanTx
+{
+    uint16_t tx_dropped[TELEMETRY_CAN_BUSES]; /**< Frames dropped by the TX queue of each bus in McpIndex order, buses sharing an MCP2515 share its count */
+    uint16_t tx_coalesced;                    /**< Unsent frames replaced by newer data, all TX queues together, saturating */
+
+    /**
+     * @brief Converts the TelemetryFrameCanTx to a CAN frame.
+     * @return CAN frame with the drop counts of the motor, BMS and datalogger buses then the coalesced count, little endian.
+     */
+    constexpr can_frame toCanFrame() const
+    {
+        return can_frame{
+            TELEMETRY_CAN_TX_MSG, // can_id
+            8,                    // can_dlc
+            static_cast<__u8>(tx_dropped[0] & 0xFF),
+            static_cast<__u8>((tx_dropped[0] >> 8) & 0xFF),
+            static_cast<__u8>(tx_dropped[1] & 0xFF),
+            static_cast<__u8>((tx_dropped[1] >> 8) & 0xFF),
+            static_cast<__u8>(tx_dropped[2] & 0xFF),
+            static_cast<__u8>((tx_dropped[2] >> 8) & 0xFF),
+            static_cast<__u8>(tx_coalesced & 0xFF),
+            static_cast<__u8>((tx_coalesced >> 8) & 0xFF)};
+    }
+};
+
+/**
+ * @brief Telemetry frame structure for the scheduler load shedding.
+ */
+struct TelemetryFrameScheduler
+{
+    uint16_t deferred; /**< Normal priority tasks deferred to the next tick for being over budget, since boot, saturating */
+    uint16_t dropped;  /**< Low priority tasks (telemetry) dropped for being over budget, since boot, saturating */
+
+    /**
+     * @brief Converts the TelemetryFrameScheduler to a CAN frame.
+     * @return CAN frame with the deferred then dropped counts, little endian.
+     */
+    constexpr can_frame toCanFrame() const
+    {
+        return can_frame{
+            TELEMETRY_SCHED_LOAD_MSG, // can_id
+            4,                        // can_dlc
+            static_cast<__u8>(deferred & 0xFF),
+            static_cast<__u8>((deferred >> 8) & 0xFF),
+            static_cast<__u8>(dropped & 0xFF),
+            static_cast<__u8>((dropped >> 8) & 0xFF)};
+    }
+};
+
 /**
  * @brief Represents the state of the car.
  * Holds telemetry data and status, used as central data sharing structure.
  *
- * @see TelemetryFramePedal, TelemetryFrameMotor, TelemetryFrameBms
+ * @see TelemetryFramePedal, TelemetryFrameMotor, TelemetryFrameBms, TelemetryFrameCan, TelemetryFrameCanTx, TelemetryFrameScheduler
  */
 struct CarState
 {
-    TelemetryFramePedal pedal; /**< Struct holding pedal telemetry data, ready for sending over CAN */
-    TelemetryFrameMotor motor; /**< Struct holding motor telemetry data, ready for sending over CAN */
-    TelemetryFrameBms bms;     /**< Struct holding BMS telemetry data, ready for sending over CAN */
-    uint32_t status_millis;    /**< Millisecond counter for the current car status (for state transitions) */
-    uint32_t millis;           /**< Current time in milliseconds for the current loop iteration */
+    TelemetryFramePedal pedal;  /**< Struct holding pedal telemetry data, ready for sending over CAN */
+    TelemetryFrameMotor motor;  /**< Struct holding motor telemetry data, ready for sending over CAN */
+    TelemetryFrameBms bms;      /**< Struct holding BMS telemetry data, ready for sending over CAN */
+    TelemetryFrameCan can;      /**< Struct holding CAN controller telemetry data, ready for sending over CAN */
+    TelemetryFrameCanTx can_tx;        /**< Struct holding CAN transmit queue telemetry data, ready for sending over CAN */
+    TelemetryFrameScheduler scheduler; /**< Struct holding scheduler load shedding telemetry data, ready for sending over CAN */
+    uint32_t status_millis;            /**< Millisecond counter for the current car status (for state transitions) */
+    uint32_t millis;                   /**< Current time in milliseconds for the current loop iteration */
 };
 #endif // CAR_STATE_HPP
\ No newline at end of file
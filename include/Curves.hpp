@@ -2,8 +2,8 @@
  * @file Curves.hpp
  * @author Planeson, Red Bird Racing
  * @brief Definition of throttle and brake mapping tables
- * @version 1.5
- * @date 2026-02-09
+ * @version 1.10
+ * @date 2026-10-16
  * @see Interp.hpp, Pedal
  */
 
@@ -12,13 +12,30 @@
 #include "Interp.hpp"
 #include <stdint.h>
 
+// === ADC resolution ===
+
+constexpr uint8_t ADC_OVERSAMPLE_BITS = 2;                                  /**< Extra bits of the APPS and brake inputs, from 4^n conversions per reading (16x for 2); 0 is plain 10-bit, at most 3 */
+constexpr uint8_t ADC_BITS = 10 + ADC_OVERSAMPLE_BITS;                      /**< Resolution of the APPS and brake readings */
+constexpr uint16_t ADC_MAX = static_cast<uint16_t>((1u << ADC_BITS) - 1); /**< Largest APPS or brake reading */
+
+/**
+ * @brief Converts a 10-bit ADC reading to the resolution of the APPS and brake readings.
+ * The limits and tables below are measured in 10-bit readings, so they stay the same whatever ADC_OVERSAMPLE_BITS is.
+ * @param code 10-bit ADC reading
+ * @return The same voltage in ADC_BITS resolution
+ */
+constexpr uint16_t adc10(const uint16_t code)
+{
+    return static_cast<uint16_t>(code << ADC_OVERSAMPLE_BITS);
+}
+
 // === APPS Limits ===
 
-constexpr uint16_t APPS_5V_MIN = 50;  /**< value below which apps_5v is considered shorted to ground */
-constexpr uint16_t APPS_5V_MAX = 950; /**< value above which apps_5v is considered shorted to rail */
+constexpr uint16_t APPS_5V_MIN = adc10(50);  /**< value below which apps_5v is considered shorted to ground */
+constexpr uint16_t APPS_5V_MAX = adc10(950); /**< value above which apps_5v is considered shorted to rail */
 
-constexpr uint16_t APPS_3V3_MIN = 50;            /**< value below which apps_3v3 is considered shorted to ground */
-constexpr uint16_t APPS_3V3_MAX = 950;           /**< value above which apps_3v3 is considered shorted to rail */
+constexpr uint16_t APPS_3V3_MIN = adc10(50);  /**< value below which apps_3v3 is considered shorted to ground */
+constexpr uint16_t APPS_3V3_MAX = adc10(950); /**< value above which apps_3v3 is considered shorted to rail */
 
 /**
  * @brief Ratio between 5V APPS and 3.3V APPS, use integer math to avoid float operations.
@@ -39,33 +56,35 @@ constexpr TablePoint<uint16_t, int16_t> CURVE_TABLE[5] = {
 
 // === Brake Limits ===
 
-constexpr uint16_t brake_min = 50;  /**< value below which brake is considered shorted to ground */
-constexpr uint16_t brake_max = 950; /**< value above which brake is considered shorted to rail */
+constexpr uint16_t brake_min = adc10(50);  /**< value below which brake is considered shorted to ground */
+constexpr uint16_t brake_max = adc10(950); /**< value above which brake is considered shorted to rail */
 
 /**
  * @brief Brake mapping table, negative values for regen
  */
 constexpr TablePoint<uint16_t, int16_t> BRAKE_TABLE[5] = {
-    {120, 0},
-    {150, -15000},
-    {180, -26000},
-    {210, -31000},
-    {240, -32500}}; // make sure this point doesn't exceed +-32767
+    {adc10(120), 0},
+    {adc10(150), -15000},
+    {adc10(180), -26000},
+    {adc10(210), -31000},
+    {adc10(240), -32500}}; // make sure this point doesn't exceed +-32767
+
+constexpr uint8_t APPS_3V3_SCALE_POINTS = 3; /**< Points of APPS_3V3_SCALE_TABLE and of a calibrated APPS_3V3 scale */
 
 /**
  * @brief APPS_3V3 mapping table, maps 3V3 readings to 5V readings
  */
-constexpr TablePoint<uint16_t, uint16_t> APPS_3V3_SCALE_TABLE[3] = {
-    {189, 325},
-    {327, 506},
-    {530, 775}};
+constexpr TablePoint<uint16_t, uint16_t> APPS_3V3_SCALE_TABLE[APPS_3V3_SCALE_POINTS] = {
+    {adc10(189), adc10(325)},
+    {adc10(327), adc10(506)},
+    {adc10(530), adc10(775)}};
 
 /**
  * @brief APPS_5V to percent mapping table, maps 5V readings to percent throttle (0-60000) 
  */
 constexpr TablePoint<uint16_t, uint16_t> APPS_5V_PERCENT_TABLE[2] = {
-    {370, 0},
-    {740, 60000}};
+    {adc10(370), 0},
+    {adc10(740), 60000}};
 
 // === calculated tables
 /**
@@ -93,4 +112,134 @@ constexpr TablePoint<uint16_t, int16_t> THROTTLE_TABLE[5] = {
     {APPS_5V_TABLE_INVERTED_MAP.interp(CURVE_TABLE[3].in), CURVE_TABLE[3].out},
     {APPS_5V_TABLE_INVERTED_MAP.interp(CURVE_TABLE[4].in), CURVE_TABLE[4].out}};
 
+// === RPM dependent maps ===
+// motor RPM breakpoints are scaled 0-32767 like car.motor.motor_rpm, 32767 is Pedal's MAX_MOTOR_RPM
+
+constexpr uint8_t TORQUE_GRID_PEDAL_POINTS = 5; /**< Columns of the TorqueProfile grids, APPS or brake breakpoints */
+constexpr uint8_t TORQUE_GRID_RPM_POINTS = 3;   /**< Rows of the TorqueProfile grids, motor RPM breakpoints */
+
+/**
+ * @brief APPS_5V breakpoints of TorqueProfile::throttle, same as THROTTLE_TABLE
+ */
+constexpr uint16_t THROTTLE_APPS_AXIS[TORQUE_GRID_PEDAL_POINTS] = {
+    THROTTLE_TABLE[0].in, THROTTLE_TABLE[1].in, THROTTLE_TABLE[2].in, THROTTLE_TABLE[3].in, THROTTLE_TABLE[4].in};
+
+/**
+ * @brief Motor RPM breakpoints of TorqueProfile::throttle
+ */
+constexpr int16_t THROTTLE_RPM_AXIS[TORQUE_GRID_RPM_POINTS] = {0, 16384, 32767};
+
+/**
+ * @brief Brake breakpoints of TorqueProfile::regen, same as BRAKE_TABLE
+ */
+constexpr uint16_t REGEN_BRAKE_AXIS[TORQUE_GRID_PEDAL_POINTS] = {
+    BRAKE_TABLE[0].in, BRAKE_TABLE[1].in, BRAKE_TABLE[2].in, BRAKE_TABLE[3].in, BRAKE_TABLE[4].in};
+
+/**
+ * @brief Motor RPM breakpoints of TorqueProfile::regen
+ * @details Regen fades in from the first breakpoint (~10km/h, must not be below Pedal's MIN_REGEN_RPM_VAL)
+ * to full at the second (~20km/h), instead of switching on at once.
+ */
+constexpr int16_t REGEN_RPM_AXIS[TORQUE_GRID_RPM_POINTS] = {3500, 7000, 32767};
+
+// === Torque profiles ===
+// one firmware for all events, the profile is picked at runtime, see Pedal::selectProfile
+
+/**
+ * @brief Throttle and regen grids of one torque profile, copied from flash into RAM when selected
+ * @note Make sure no point exceeds +-32767; the regen grid must stay 0 on its first row so there is no regen below MIN_REGEN_KMH
+ */
+struct TorqueProfile
+{
+    int16_t throttle[TORQUE_GRID_RPM_POINTS][TORQUE_GRID_PEDAL_POINTS]; /**< Throttle torque over THROTTLE_APPS_AXIS (columns) and THROTTLE_RPM_AXIS (rows) */
+    int16_t regen[TORQUE_GRID_RPM_POINTS][TORQUE_GRID_PEDAL_POINTS];    /**< Regen torque over REGEN_BRAKE_AXIS (columns) and REGEN_RPM_AXIS (rows), negative values for regen */
+};
+
+/**
+ * @brief Endurance profile, CURVE_TABLE and BRAKE_TABLE at all RPM
+ * @note Default profile at boot, and the one used by the 1D maps when RPM_TORQUE_MAP_ENABLED is false
+ */
+constexpr TorqueProfile ENDURANCE_PROFILE = {
+    {{CURVE_TABLE[0].out, CURVE_TABLE[1].out, CURVE_TABLE[2].out, CURVE_TABLE[3].out, CURVE_TABLE[4].out},   // 0 RPM
+     {CURVE_TABLE[0].out, CURVE_TABLE[1].out, CURVE_TABLE[2].out, CURVE_TABLE[3].out, CURVE_TABLE[4].out},   // half RPM
+     {CURVE_TABLE[0].out, CURVE_TABLE[1].out, CURVE_TABLE[2].out, CURVE_TABLE[3].out, CURVE_TABLE[4].out}},  // max RPM
+    {{0, 0, 0, 0, 0},                                                                                        // no regen at ~10km/h and below
+     {BRAKE_TABLE[0].out, BRAKE_TABLE[1].out, BRAKE_TABLE[2].out, BRAKE_TABLE[3].out, BRAKE_TABLE[4].out},   // full regen from ~20km/h
+     {BRAKE_TABLE[0].out, BRAKE_TABLE[1].out, BRAKE_TABLE[2].out, BRAKE_TABLE[3].out, BRAKE_TABLE[4].out}}}; // max RPM
+
+/**
+ * @brief Acceleration profile, near linear throttle for full torque early in the pedal travel
+ */
+constexpr TorqueProfile ACCELERATION_PROFILE = {
+    {{0, 6000, 18000, 30000, 32500},                                                                         // 0 RPM
+     {0, 6000, 18000, 30000, 32500},                                                                         // half RPM
+     {0, 6000, 18000, 30000, 32500}},                                                                        // max RPM
+    {{0, 0, 0, 0, 0},                                                                                        // no regen at ~10km/h and below
+     {BRAKE_TABLE[0].out, BRAKE_TABLE[1].out, BRAKE_TABLE[2].out, BRAKE_TABLE[3].out, BRAKE_TABLE[4].out},   // full regen from ~20km/h
+     {BRAKE_TABLE[0].out, BRAKE_TABLE[1].out, BRAKE_TABLE[2].out, BRAKE_TABLE[3].out, BRAKE_TABLE[4].out}}}; // max RPM
+
+/**
+ * @brief Skidpad profile, soft throttle capped below full torque and light regen to keep the rear planted
+ */
+constexpr TorqueProfile SKIDPAD_PROFILE = {
+    {{0, 1500, 7000, 16000, 24000},        // 0 RPM
+     {0, 1500, 7000, 16000, 24000},        // half RPM
+     {0, 1500, 7000, 16000, 24000}},       // max RPM
+    {{0, 0, 0, 0, 0},                      // no regen at ~10km/h and below
+     {0, -10000, -17000, -21000, -22000},  // full regen from ~20km/h
+     {0, -10000, -17000, -21000, -22000}}}; // max RPM
+
+// === Calibration checks ===
+// used by static_assert for the tables above, and at runtime for tables received over the calibration channel
+
+/**
+ * @brief Checks that a torque profile is safe to drive with
+ * @details Throttle must be non-negative and non-decreasing over APPS, regen non-positive and non-increasing over brake,
+ * no value may be -32768 (torque is +-32767), both grids must be 0 with the pedals released,
+ * and regen must be 0 on its first RPM row.
+ * @param profile The profile to check
+ * @return true if the profile is valid
+ */
+constexpr bool validProfile(const TorqueProfile &profile)
+{
+    for (uint8_t j = 0; j < TORQUE_GRID_RPM_POINTS; ++j)
+    {
+        if (profile.throttle[j][0] != 0 || profile.regen[j][0] != 0)
+            return false;
+        for (uint8_t i = 1; i < TORQUE_GRID_PEDAL_POINTS; ++i)
+        {
+            if (profile.throttle[j][i] < profile.throttle[j][i - 1])
+                return false;
+            if (profile.regen[j][i] > profile.regen[j][i - 1] || profile.regen[j][i] < -32767)
+                return false;
+            if (j == 0 && profile.regen[j][i] != 0)
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks that an APPS_3V3 scale table can be interpolated and keeps the pedal fault check meaningful
+ * @details Inputs must be strictly increasing and inside the ADC range (ADC_MAX), outputs non-decreasing and inside it too.
+ * @param table The table to check
+ * @return true if the table is valid
+ */
+constexpr bool validApps3v3Scale(const TablePoint<uint16_t, uint16_t> (&table)[APPS_3V3_SCALE_POINTS])
+{
+    for (uint8_t i = 0; i < APPS_3V3_SCALE_POINTS; ++i)
+    {
+        if (table[i].in > ADC_MAX || table[i].out > ADC_MAX)
+            return false;
+        if (i > 0 && (table[i].in <= table[i - 1].in || table[i].out < table[i - 1].out))
+            return false;
+    }
+    return true;
+}
+
+static_assert(validProfile(ENDURANCE_PROFILE), "ENDURANCE_PROFILE fails validProfile");
+static_assert(validProfile(ACCELERATION_PROFILE), "ACCELERATION_PROFILE fails validProfile");
+static_assert(validProfile(SKIDPAD_PROFILE), "SKIDPAD_PROFILE fails validProfile");
+static_assert(validApps3v3Scale(APPS_3V3_SCALE_TABLE), "APPS_3V3_SCALE_TABLE fails validApps3v3Scale");
+
 #endif // CURVES_HPP
\ No newline at end of file
@@ -2,14 +2,13 @@
  * @file Enums.hpp
  * @author Planeson, Red Bird Racing
  * @brief Enumeration definitions for the VCU
- * @version 1.3.1
- * @date 2026-02-09
+ * @version 1.9.1
+ * @date 2026-10-16
  */
 
 #ifndef ENUMS_HPP
 #define ENUMS_HPP
 #include <stdint.h>
-#include <can.h> // canid_t
 
 /**
  * @brief Main car status state machine.
@@ -69,14 +68,95 @@ enum class McpIndex : uint8_t
     Datalogger = 2 /**< Datalogger CAN MCP2515 instance */
 };
 
+/**
+ * @brief Implementation used to evaluate an interpolation map.
+ *
+ * All modes give identical results for the tables in Curves.hpp, they trade memory for speed.
+ */
+enum class MapMode : uint8_t
+{
+    Divide = 0,     /**< LinearInterp, segment lookup and 32-bit divide, no extra memory */
+    FixedSlope = 1, /**< FixedSlopeInterp, segment lookup and multiply-shift, 8 bytes RAM per segment */
+    FlashLut = 2    /**< FlashLut, single flash read, 2KB flash per map; FlashAxisLut for a grid axis, 3KB flash */
+};
+
+/**
+ * @brief Analog inputs filtered by Pedal, the channel order of its FilterBank.
+ */
+enum class PedalInput : uint8_t
+{
+    Apps5v = 0,    /**< APPS_5V */
+    Apps3v3 = 1,   /**< APPS_3V3 */
+    Brake = 2      /**< BRAKE_IN */
+};
+constexpr uint8_t PEDAL_INPUT_COUNT = 3; /**< Number of PedalInput channels */
+
+/**
+ * @brief Torque profiles stored in flash, one per event.
+ *
+ * Used as the index into Pedal's profile table and as the payload of the profile select command.
+ */
+enum class TorqueProfileId : uint8_t
+{
+    Endurance = 0,    /**< ENDURANCE_PROFILE, default at boot */
+    Acceleration = 1, /**< ACCELERATION_PROFILE */
+    Skidpad = 2,      /**< SKIDPAD_PROFILE */
+    Calibrated = 3    /**< Profile received over the calibration channel or loaded from EEPROM, not in flash */
+};
+constexpr uint8_t TORQUE_PROFILE_COUNT = 3; /**< Number of profiles in flash, Calibrated excluded */
+
+/**
+ * @brief Tables that can be written over the calibration channel.
+ */
+enum class CalibrationTable : uint8_t
+{
+    Throttle = 0,    /**< TorqueProfile::throttle, written by row and column */
+    Regen = 1,       /**< TorqueProfile::regen, written by row and column */
+    Apps3v3Scale = 2 /**< APPS_3V3 scale table, written by point as input and output */
+};
+
+/**
+ * @brief Actions of the calibration control command.
+ */
+enum class CalibrationAction : uint8_t
+{
+    Begin = 0,  /**< Copy the tables in use into the edit buffer */
+    Apply = 1,  /**< Validate the edit buffer and swap it in at the next tick boundary */
+    Commit = 2, /**< Save the tables in use to EEPROM, loaded at boot */
+    Erase = 3   /**< Invalidate the EEPROM copy, boot with the flash tables again */
+};
+
+/**
+ * @brief Result of a calibration command, sent back in the acknowledge frame.
+ */
+enum class CalibrationResult : uint8_t
+{
+    Ok = 0,         /**< Command done */
+    NotEditing = 1, /**< Write or apply without Begin */
+    BadIndex = 2,   /**< Table, row, column or point out of range */
+    Invalid = 3,    /**< Tables failed validProfile or validApps3v3Scale */
+    NotAllowed = 4, /**< EEPROM access refused while in Drive, it blocks for hundreds of ms */
+    NoRecord = 5    /**< No valid EEPROM copy */
+};
+
+/**
+ * @brief Scheduler task priority, decides what is shed when a tick uses up its time budget.
+ */
+enum class TaskPriority : uint8_t
+{
+    Critical = 0, /**< Runs before all others, every time it is due, never shed */
+    Normal = 1,   /**< Deferred to the next tick when over budget */
+    Low = 2       /**< Dropped until it is next due when over budget */
+};
+
 // === CAN IDs ===
 
 /**
  * @brief CAN message IDs for status and brake debug.
  *
- * Used for sending car status and brake messages over CAN bus.
+ * Used for sending car status and brake messages over CAN bus. Standard 11-bit IDs, cast to canid_t to send.
  */
-enum class StatusCanId : canid_t
+enum class StatusCanId : uint16_t
 {
     CarMsg = 0x693,          /**< Debug: car status message */
     StaCarChangeMsg = 0x694, /**< Debug: car status change message */
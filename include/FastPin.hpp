@@ -0,0 +1,111 @@
+/**
+ * @file FastPin.hpp
+ * @author Planeson, Red Bird Racing
+ * @brief Declaration and definition of the FastPin class template for direct port access to the BoardConfig.h pins
+ * @version 1.0
+ * @date 2026-10-16
+ * @see BoardConfig.h
+ */
+
+#ifndef FAST_PIN_HPP
+#define FAST_PIN_HPP
+
+#include <stdint.h>
+#include <avr/io.h> // _SFR_MEM8
+
+/**
+ * @brief Data memory address of the PINx register of an Arduino digital pin on the ATmega328P.
+ * DDRx and PORTx follow at +1 and +2. Pins 0-7 are PD0-PD7, 8-13 are PB0-PB5, 14-19 are PC0-PC5.
+ * @param pin Arduino pin number, e.g. PIN_PD5.
+ * @return Address of PIND (0x29), PINB (0x23) or PINC (0x26).
+ */
+constexpr uint8_t pinRegister(const uint8_t pin)
+{
+    return pin < 8 ? 0x29 : pin < 14 ? 0x23 : 0x26;
+}
+
+/**
+ * @brief Bit mask of an Arduino digital pin in its port registers on the ATmega328P.
+ * @param pin Arduino pin number, e.g. PIN_PD5.
+ * @return Single-bit mask.
+ */
+constexpr uint8_t pinMask(const uint8_t pin)
+{
+    return static_cast<uint8_t>(1u << (pin < 8 ? pin : pin < 14 ? pin - 8 : pin - 14));
+}
+
+/**
+ * @brief Direct port access to a pin known at compile time, replacing digitalRead and digitalWrite in the loop.
+ * @details The register address and mask are constants, so with optimization each access compiles to a single
+ * sbi, cbi, sbis or sbic instruction, where digitalWrite looks the port up in flash tables, checks for PWM on the pin
+ * and saves and restores SREG, dozens of cycles every call.
+ * write() reads the PORTx bit first and only writes on a change, so calling it every loop leaves the pin alone.
+ * Unlike digitalWrite, write() doesn't turn off PWM on the pin, don't mix it with analogWrite.
+ *
+ * Only the digital pins 0-19 have a port, ADC6 and ADC7 (PIN_A6, PIN_A7) are analog only.
+ * All functions are static, use it through an alias, e.g. using BrakeLight = FastPin<BRAKE_LIGHT>;
+ * @tparam PIN Arduino pin number from BoardConfig.h.
+ */
+template <uint8_t PIN>
+class FastPin
+{
+    static_assert(PIN < 20, "FastPin supports the digital pins 0-19 (PD, PB, PC) only");
+
+public:
+    static constexpr uint8_t PIN_REG = pinRegister(PIN); /**< Address of PINx */
+    static constexpr uint8_t DDR_REG = PIN_REG + 1;      /**< Address of DDRx */
+    static constexpr uint8_t PORT_REG = PIN_REG + 2;     /**< Address of PORTx */
+    static constexpr uint8_t MASK = pinMask(PIN);        /**< Bit of the pin in each register */
+
+    /**
+     * @brief Makes the pin an output, same as pinMode(PIN, OUTPUT).
+     */
+    static void output() { _SFR_MEM8(DDR_REG) |= MASK; }
+
+    /**
+     * @brief Makes the pin an input without pull-up, same as pinMode(PIN, INPUT).
+     */
+    static void input()
+    {
+        _SFR_MEM8(DDR_REG) &= static_cast<uint8_t>(~MASK);
+        _SFR_MEM8(PORT_REG) &= static_cast<uint8_t>(~MASK);
+    }
+
+    /**
+     * @brief Reads the pin level.
+     * @return true if the pin is high.
+     */
+    static bool read() { return (_SFR_MEM8(PIN_REG) & MASK) != 0; }
+
+    /**
+     * @brief Returns the level the pin is driven to.
+     * @return true if the PORTx bit is set.
+     */
+    static bool driven() { return (_SFR_MEM8(PORT_REG) & MASK) != 0; }
+
+    /**
+     * @brief Drives the pin high.
+     */
+    static void high() { _SFR_MEM8(PORT_REG) |= MASK; }
+
+    /**
+     * @brief Drives the pin low.
+     */
+    static void low() { _SFR_MEM8(PORT_REG) &= static_cast<uint8_t>(~MASK); }
+
+    /**
+     * @brief Drives the pin to a level, only writing the port if it changes.
+     * @param level true for high.
+     */
+    static void write(const bool level)
+    {
+        if (level == driven())
+            return;
+        if (level)
+            high();
+        else
+            low();
+    }
+};
+
+#endif // FAST_PIN_HPP
@@ -1,9 +1,9 @@
 /**
  * @file Interp.hpp
  * @author Planeson, Red Bird Racing
- * @brief Declaration and definition of the LinearInterp class template for linear interpolation
- * @version 1.2.3
- * @date 2026-02-09
+ * @brief Declaration and definition of the LinearInterp class template for linear interpolation, with FixedSlopeInterp and FlashLut as faster variants, and BilinearInterp for 2D maps with FlashAxisLut for its x axis
+ * @version 1.10.0
+ * @date 2026-10-16
  */
 
 #ifndef INTERP_HPP
@@ -11,6 +11,21 @@
 
 #include <stdint.h>
 
+#ifdef __AVR__
+#include <avr/pgmspace.h> // PROGMEM, pgm_read_word
+#else
+// host builds (native tests) have a flat address space, flash reads are normal reads
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#ifndef pgm_read_word
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#endif
+#ifndef pgm_read_byte
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#endif
+#endif
+
 /**
  * @brief Structure representing a point in the interpolation table
  * @tparam Tin Type of the input value
@@ -23,8 +38,153 @@ struct TablePoint
     Tout out; /**< Output (y) value */
 };
 
+/**
+ * @brief Returns the input of a table point, used by the segment lookup
+ * @param point The table point
+ * @return The input (x) value
+ */
+template <typename Tin, typename Tout>
+constexpr Tin pointInput(const TablePoint<Tin, Tout> &point)
+{
+    return point.in;
+}
+
+/**
+ * @brief Returns an axis value as is, so the segment lookup also works on plain axis arrays
+ * @param value The axis value
+ * @return The same value
+ */
+template <typename Tin>
+constexpr Tin pointInput(const Tin &value)
+{
+    return value;
+}
+
+/**
+ * @brief Unrolled binary search for the segment of an interpolation table containing the input
+ * @details Invariant: table[lo].in <= input < table[lo + width].in.
+ * Every level is its own instantiation, so the search compiles to a fixed tree of about log2(size) comparisons with no loop,
+ * and the cost is the same for every input.
+ * @tparam Tin Type of the input values
+ * @tparam Tpoint Type of the table entries, TablePoint or a plain input value for axes
+ * @tparam size Number of points in the interpolation table
+ * @tparam lo Index of the lower bound point
+ * @tparam width Number of segments left to search
+ */
+template <typename Tin, typename Tpoint, uint8_t size, uint8_t lo, uint8_t width>
+struct SegmentSearch
+{
+    /**
+     * @brief Finds the segment containing the input
+     * @param table The interpolation table
+     * @param input The input value, must be within (table[lo].in, table[lo + width].in)
+     * @return Index of the upper point of the segment
+     */
+    static constexpr uint8_t find(const Tpoint (&table)[size], const Tin input)
+    {
+        return input < pointInput(table[lo + width / 2])
+                   ? SegmentSearch<Tin, Tpoint, size, lo, width / 2>::find(table, input)
+                   : SegmentSearch<Tin, Tpoint, size, lo + width / 2, width - width / 2>::find(table, input);
+    }
+};
+
+/**
+ * @brief Leaf of SegmentSearch, a single segment is left
+ */
+template <typename Tin, typename Tpoint, uint8_t size, uint8_t lo>
+struct SegmentSearch<Tin, Tpoint, size, lo, 1>
+{
+    /**
+     * @brief Returns the only segment left
+     * @return Index of the upper point of the segment
+     */
+    static constexpr uint8_t find(const Tpoint (&)[size], const Tin)
+    {
+        return lo + 1;
+    }
+};
+
+/**
+ * @brief Class template for finding the segment of an interpolation table containing an input in constant time
+ * @details The constructor checks at compile time whether the table inputs are uniformly spaced.
+ * If so, the segment is computed directly with a 16x16-bit multiply by the reciprocal of the step, then corrected by at most one;
+ * otherwise it falls back to the unrolled SegmentSearch.
+ * @tparam Tin Type of the input values
+ * @tparam Tpoint Type of the table entries, TablePoint or a plain input value for axes
+ * @tparam size Number of points in the interpolation table
+ */
+template <typename Tin, typename Tpoint, uint8_t size>
+class SegmentIndex
+{
+    static_assert(size >= 2, "Interpolation table needs at least 2 points");
+
+public:
+    SegmentIndex() = delete; /**< Default constructor deleted to prevent instantiation without a table */
+
+    /**
+     * @brief Detects uniform spacing of the table, only meant to be evaluated at compile time
+     * @param table The interpolation table
+     */
+    explicit constexpr SegmentIndex(const Tpoint (&table)[size])
+        : step(uniformStep(table)),
+          reciprocal(step ? static_cast<uint16_t>((static_cast<uint32_t>(65536) + step - 1) / step) : 0)
+    {
+    }
+
+    /**
+     * @brief Finds the segment containing the input
+     * @param table The interpolation table, same as given to the constructor
+     * @param input The input value, must be strictly between the first and last input of the table
+     * @return Index of the upper point of the segment, from 1 to size - 1
+     */
+    constexpr uint8_t find(const Tpoint (&table)[size], const Tin input) const
+    {
+        if (step == 0)
+            return SegmentSearch<Tin, Tpoint, size, 0, size - 1>::find(table, input);
+        // reciprocal is rounded up, so the estimate is the segment or the one after it
+        uint8_t lower = static_cast<uint8_t>((static_cast<uint32_t>(static_cast<uint16_t>(input - pointInput(table[0]))) * reciprocal) >> 16);
+        if (input < pointInput(table[lower]))
+            --lower;
+        return lower + 1;
+    }
+
+    /**
+     * @brief Returns whether the table is uniformly spaced and uses the direct index computation
+     * @return true if uniform
+     */
+    constexpr bool uniform() const
+    {
+        return step != 0;
+    }
+
+private:
+    uint16_t step;       /**< Input step between points if uniformly spaced, 0 if not */
+    uint16_t reciprocal; /**< 2^16 / step, rounded up */
+
+    /**
+     * @brief Computes the input step if the table is uniformly spaced
+     * @param table The interpolation table
+     * @return The step, or 0 if not uniform, the step is below 2, or Tin is wider than 16-bit
+     */
+    static constexpr uint16_t uniformStep(const Tpoint (&table)[size])
+    {
+        if (sizeof(Tin) > 2)
+            return 0;
+        const int32_t first = static_cast<int32_t>(pointInput(table[1])) - pointInput(table[0]);
+        if (first < 2)
+            return 0; // reciprocal of 1 doesn't fit in 16-bit, and a search is as fast anyway
+        for (uint8_t i = 2; i < size; ++i)
+        {
+            if (static_cast<int32_t>(pointInput(table[i])) - pointInput(table[i - 1]) != first)
+                return 0;
+        }
+        return static_cast<uint16_t>(first);
+    }
+};
+
 /**
  * @brief Class template for performing linear interpolation using a lookup table
+ * @details Assignable, so an interpolation of a table in RAM can be rebuilt once when the table changes instead of per call.
  * @tparam Tin Type of the input values
  * @tparam Tout Type of the output values
  * @tparam Tmid Intermediate type for calculations to prevent overflow
@@ -35,7 +195,7 @@ class LinearInterp
 {
 public:
     LinearInterp() = delete; /**< Default constructor deleted to prevent instantiation without a table */
-    explicit constexpr LinearInterp(const TablePoint<Tin, Tout> (&table_)[size]) : table(table_) {} /**< Normal constructor */
+    explicit constexpr LinearInterp(const TablePoint<Tin, Tout> (&table_)[size]) : table(&table_), segments(table_) {} /**< Normal constructor */
 
     /**
      * @brief Performs linear interpolation for the given input value, using the table
@@ -43,6 +203,102 @@ public:
      * @return The interpolated output value
      */
     constexpr Tout interp(Tin input) const
+    {
+        // Clamp below first point
+        if (input <= (*table)[0].in)
+            return (*table)[0].out;
+        // Clamp above last point
+        if (input >= (*table)[size - 1].in)
+            return (*table)[size - 1].out;
+        // Find segment
+        const uint8_t i = segments.find(*table, input);
+        const TablePoint<Tin, Tout> &p0 = (*table)[i - 1];
+        const TablePoint<Tin, Tout> &p1 = (*table)[i];
+        // Linear interpolation, all integer math
+        Tmid deltaIn = p1.in - p0.in;
+        Tmid deltaOut = p1.out - p0.out;
+        return p0.out + ((Tmid)(input - p0.in) * deltaOut) / deltaIn; // see FixedSlopeInterp for a division-free variant
+    }
+
+    /**
+     * @brief Returns the starting input value of the interpolation table
+     * @return The starting input value
+     */
+    constexpr Tin start() const
+    {
+        return (*table)[0].in;
+    }
+
+    /**
+     * @brief Returns the input range of the interpolation table (last input - first input)
+     * @return The input range of the table
+     */
+    constexpr Tin range() const
+    {
+        return (*table)[size - 1].in - (*table)[0].in;
+    }
+
+    /**
+     * @brief Returns whether the table is uniformly spaced, making the segment lookup a direct index computation
+     * @return true if uniform
+     */
+    constexpr bool uniform() const
+    {
+        return segments.uniform();
+    }
+
+private:
+    const TablePoint<Tin, Tout> (*table)[size];             /**< Pointer to the interpolation table */
+    SegmentIndex<Tin, TablePoint<Tin, Tout>, size> segments; /**< Segment lookup for the table */
+};
+
+/**
+ * @brief Class template for division-free linear interpolation, a drop-in variant of LinearInterp
+ * @details Per-segment slopes are precomputed at compile time as fixed-point multipliers with SHIFT fractional bits,
+ * so interp() is a multiply, an add and a shift instead of a Tmid division.
+ * SHIFT is chosen by the constructor as the largest that cannot overflow Tmid for the given table.
+ * Slope magnitudes are rounded up and negative segments get a rounding bias, so results round toward zero like LinearInterp;
+ * a result is exact when the segment's input width squared is below 2^SHIFT, otherwise at most 1 off, check with maxError().
+ * Costs sizeof(Tmid) * 2 bytes per segment over LinearInterp.
+ * @note As with LinearInterp, decreasing tables need a signed Tmid.
+ * @tparam Tin Type of the input values
+ * @tparam Tout Type of the output values
+ * @tparam Tmid Intermediate type for calculations to prevent overflow, at most 32-bit
+ * @tparam size Number of points in the interpolation table
+ */
+template <typename Tin, typename Tout, typename Tmid, uint8_t size>
+class FixedSlopeInterp
+{
+    static_assert(sizeof(Tmid) <= 4, "FixedSlopeInterp sizes SHIFT with 64-bit math, Tmid must be at most 32-bit");
+
+public:
+    FixedSlopeInterp() = delete; /**< Default constructor deleted to prevent instantiation without a table */
+
+    /**
+     * @brief Computes SHIFT and the per-segment slopes, only meant to be evaluated at compile time
+     * @param table_ The interpolation table
+     */
+    explicit constexpr FixedSlopeInterp(const TablePoint<Tin, Tout> (&table_)[size])
+        : table(table_), segments(table_), shift(chooseShift(table_)), slopes{}, biases{}
+    {
+        for (uint8_t i = 1; i < size; ++i)
+        {
+            const int64_t delta_in = static_cast<int64_t>(table[i].in) - table[i - 1].in;
+            const int64_t delta_out = static_cast<int64_t>(table[i].out) - table[i - 1].out;
+            const uint64_t magnitude = static_cast<uint64_t>(delta_out < 0 ? -delta_out : delta_out) << shift;
+            // round magnitude up, result is then floored toward zero, same as the divide
+            const Tmid slope = static_cast<Tmid>((magnitude + delta_in - 1) / delta_in);
+            slopes[i - 1] = delta_out < 0 ? static_cast<Tmid>(-slope) : slope;
+            biases[i - 1] = delta_out < 0 ? static_cast<Tmid>((static_cast<Tmid>(1) << shift) - 1) : 0;
+        }
+    }
+
+    /**
+     * @brief Performs linear interpolation for the given input value, using the precomputed slopes
+     * @param input The input value to interpolate
+     * @return The interpolated output value
+     */
+    constexpr Tout interp(Tin input) const
     {
         // Clamp below first point
         if (input <= table[0].in)
@@ -51,20 +307,36 @@ public:
         if (input >= table[size - 1].in)
             return table[size - 1].out;
         // Find segment
-        for (uint8_t i = 1; i < size; ++i)
+        const uint8_t i = segments.find(table, input);
+        return table[i - 1].out + static_cast<Tout>(((Tmid)(input - table[i - 1].in) * slopes[i - 1] + biases[i - 1]) >> shift);
+    }
+
+    /**
+     * @brief Returns the largest difference to LinearInterp::interp() over the whole table, for static_assert
+     * @return The worst absolute error, 0 if all results are identical
+     */
+    constexpr Tmid maxError() const
+    {
+        const LinearInterp<Tin, Tout, Tmid, size> exact{table};
+        Tmid worst = 0;
+        for (Tin input = table[0].in; input < table[size - 1].in; ++input)
         {
-            if (input < table[i].in)
-            {
-                const TablePoint<Tin, Tout> &p0 = table[i - 1];
-                const TablePoint<Tin, Tout> &p1 = table[i];
-                // Linear interpolation, all integer math
-                Tmid deltaIn = p1.in - p0.in;
-                Tmid deltaOut = p1.out - p0.out;
-                return p0.out + ((Tmid)(input - p0.in) * deltaOut) / deltaIn; // can omit Tmid if slope is integer, but assume enough performance for now
-            }
+            const Tmid fixed_out = interp(input);
+            const Tmid exact_out = exact.interp(input);
+            const Tmid error = fixed_out > exact_out ? fixed_out - exact_out : exact_out - fixed_out;
+            if (error > worst)
+                worst = error;
         }
-        // Should never reach here
-        return table[size - 1].out;
+        return worst;
+    }
+
+    /**
+     * @brief Returns the number of fractional bits of the slopes
+     * @return SHIFT
+     */
+    constexpr uint8_t fractionBits() const
+    {
+        return shift;
     }
 
     /**
@@ -85,8 +357,303 @@ public:
         return table[size - 1].in - table[0].in;
     }
 
+    /**
+     * @brief Returns whether the table is uniformly spaced, making the segment lookup a direct index computation
+     * @return true if uniform
+     */
+    constexpr bool uniform() const
+    {
+        return segments.uniform();
+    }
+
+private:
+    const TablePoint<Tin, Tout> (&table)[size];   /**< Reference to the interpolation table */
+    const SegmentIndex<Tin, TablePoint<Tin, Tout>, size> segments; /**< Segment lookup for the table */
+    const uint8_t shift;                          /**< SHIFT, fractional bits of the slopes */
+    Tmid slopes[size - 1];                        /**< Slope of each segment, scaled by 2^SHIFT */
+    Tmid biases[size - 1];                        /**< Rounding bias of each segment, 2^SHIFT - 1 for negative slopes so they round toward zero */
+
+    /**
+     * @brief Picks the largest SHIFT where (input - p0.in) * slope + bias fits in Tmid for every segment
+     * @param table_ The interpolation table
+     * @return SHIFT
+     */
+    static constexpr uint8_t chooseShift(const TablePoint<Tin, Tout> (&table_)[size])
+    {
+        const uint64_t tmid_max = (static_cast<Tmid>(-1) < 0) ? (static_cast<uint64_t>(1) << (sizeof(Tmid) * 8 - 1)) - 1
+                                                             : (static_cast<uint64_t>(1) << (sizeof(Tmid) * 8)) - 1;
+        uint8_t best = 0;
+        for (uint8_t candidate = 1; candidate < sizeof(Tmid) * 8 - 1; ++candidate)
+        {
+            const uint64_t one = static_cast<uint64_t>(1) << candidate;
+            bool fits = true;
+            for (uint8_t i = 1; i < size; ++i)
+            {
+                const int64_t delta_in = static_cast<int64_t>(table_[i].in) - table_[i - 1].in;
+                const int64_t delta_out = static_cast<int64_t>(table_[i].out) - table_[i - 1].out;
+                const uint64_t magnitude = static_cast<uint64_t>(delta_out < 0 ? -delta_out : delta_out);
+                // product is at most |delta_out| * 2^SHIFT + delta_in - 1, plus the bias of 2^SHIFT - 1
+                if (magnitude * one + delta_in + one > tmid_max)
+                    fits = false;
+            }
+            if (!fits)
+                break;
+            best = candidate;
+        }
+        return best;
+    }
+};
+
+/**
+ * @brief Position of an input on an interpolation axis, see BilinearInterp::locateX
+ */
+struct AxisPosition
+{
+    uint8_t index;     /**< Index of the upper breakpoint of the segment */
+    uint16_t fraction; /**< Position inside the segment in Q(BilinearInterp::FRACTION_BITS), 0 at the lower breakpoint */
+};
+
+/**
+ * @brief Class template for bilinear interpolation on a 2D grid, e.g. torque over pedal and motor RPM
+ * @details The grid is indexed [y][x], so each row is a curve over the x axis at one y breakpoint.
+ * Inputs outside an axis are clamped to its first or last breakpoint.
+ * Both axes use SegmentIndex for the segment lookup, and the position inside a segment is turned into a Q14 fraction
+ * with a per-segment reciprocal computed at compile time, so interp() is integer multiplies and shifts with no division.
+ * Fractions and products are rounded to nearest, so results are exact on the grid points and between them within
+ * about 1 + (largest step between neighbouring grid values) / 2^14 of the exact bilinear value, i.e. 5 for full-scale steps.
+ * @tparam Tx Type of the x axis values, at most 16-bit
+ * @tparam Ty Type of the y axis values, at most 16-bit
+ * @tparam Tout Type of the output values, at most 16-bit
+ * @tparam Tmid Signed intermediate type for calculations, at least 32-bit
+ * @tparam size_x Number of breakpoints on the x axis
+ * @tparam size_y Number of breakpoints on the y axis
+ */
+template <typename Tx, typename Ty, typename Tout, typename Tmid, uint8_t size_x, uint8_t size_y>
+class BilinearInterp
+{
+    static_assert(sizeof(Tx) <= 2 && sizeof(Ty) <= 2 && sizeof(Tout) <= 2, "BilinearInterp fractions assume 16-bit axes and outputs");
+    static_assert(sizeof(Tmid) >= 4 && static_cast<Tmid>(-1) < 0, "BilinearInterp needs a signed 32-bit Tmid");
+
+public:
+    static constexpr uint8_t FRACTION_BITS = 14; /**< Fractional bits of the position inside a segment */
+
+    BilinearInterp() = delete; /**< Default constructor deleted to prevent instantiation without axes */
+
+    /**
+     * @brief Computes the segment lookups and reciprocals of both axes, only meant to be evaluated at compile time
+     * @details The grid is passed on each interp() call instead of being bound here,
+     * so grids sharing the same axes (e.g. torque profiles) share one map.
+     * @param x_axis_ Strictly increasing x breakpoints
+     * @param y_axis_ Strictly increasing y breakpoints
+     */
+    explicit constexpr BilinearInterp(const Tx (&x_axis_)[size_x], const Ty (&y_axis_)[size_y])
+        : x_axis(x_axis_), y_axis(y_axis_),
+          x_segments(x_axis_), y_segments(y_axis_),
+          x_reciprocals{}, y_reciprocals{}
+    {
+        for (uint8_t i = 1; i < size_x; ++i)
+            x_reciprocals[i - 1] = reciprocal(static_cast<int32_t>(x_axis[i]) - x_axis[i - 1]);
+        for (uint8_t i = 1; i < size_y; ++i)
+            y_reciprocals[i - 1] = reciprocal(static_cast<int32_t>(y_axis[i]) - y_axis[i - 1]);
+    }
+
+    /**
+     * @brief Performs bilinear interpolation for the given inputs over a grid
+     * @param x The x input value
+     * @param y The y input value
+     * @param grid Output at each breakpoint, indexed [y][x], must be in RAM
+     * @return The interpolated output value
+     */
+    constexpr Tout interp(Tx x, Ty y, const Tout (&grid)[size_y][size_x]) const
+    {
+        return interpAt(locateX(x), y, grid);
+    }
+
+    /**
+     * @brief Performs bilinear interpolation with the x input already located, e.g. by a FlashAxisLut
+     * @param x Position of the x input, from locateX
+     * @param y The y input value
+     * @param grid Output at each breakpoint, indexed [y][x], must be in RAM
+     * @return The interpolated output value, identical to interp() for the x input located
+     */
+    constexpr Tout interpAt(const AxisPosition x, Ty y, const Tout (&grid)[size_y][size_x]) const
+    {
+        uint16_t fraction_y = 0;
+        const uint8_t j = locate(y_axis, y_segments, y_reciprocals, y, fraction_y);
+        const Tmid lower = lerp(grid[j - 1][x.index - 1], grid[j - 1][x.index], x.fraction);
+        const Tmid upper = lerp(grid[j][x.index - 1], grid[j][x.index], x.fraction);
+        return static_cast<Tout>(lerp(lower, upper, fraction_y));
+    }
+
+    /**
+     * @brief Finds the segment of the x axis containing the input and the position inside it
+     * @param x The x input value, clamped to the axis
+     * @return Position of x, for interpAt
+     */
+    constexpr AxisPosition locateX(const Tx x) const
+    {
+        uint16_t fraction = 0;
+        const uint8_t index = locate(x_axis, x_segments, x_reciprocals, x, fraction);
+        return AxisPosition{index, fraction};
+    }
+
+private:
+    static constexpr uint16_t FRACTION_ONE = static_cast<uint16_t>(1) << FRACTION_BITS; /**< 1.0 in Q14 */
+    static constexpr uint8_t RECIPROCAL_EXTRA_BITS = 17;                                 /**< Extra precision bits of the reciprocals, dropped after the multiply; offset * reciprocal stays below 2^31 */
+
+    const Tx (&x_axis)[size_x];                    /**< Reference to the x breakpoints */
+    const Ty (&y_axis)[size_y];                    /**< Reference to the y breakpoints */
+    const SegmentIndex<Tx, Tx, size_x> x_segments; /**< Segment lookup for the x axis */
+    const SegmentIndex<Ty, Ty, size_y> y_segments; /**< Segment lookup for the y axis */
+    uint32_t x_reciprocals[size_x - 1];            /**< 2^31 / width of each x segment, rounded down so fractions stay below 1.0 */
+    uint32_t y_reciprocals[size_y - 1];            /**< 2^31 / width of each y segment, rounded down so fractions stay below 1.0 */
+
+    /**
+     * @brief Computes the reciprocal of a segment width
+     * @param width Width of the segment, must be positive
+     * @return 2^(FRACTION_BITS + RECIPROCAL_EXTRA_BITS) / width, rounded down
+     */
+    static constexpr uint32_t reciprocal(const int32_t width)
+    {
+        return (static_cast<uint32_t>(FRACTION_ONE) << RECIPROCAL_EXTRA_BITS) / static_cast<uint32_t>(width);
+    }
+
+    /**
+     * @brief Finds the segment of an axis containing the value and the Q14 position inside it
+     * @param axis The axis breakpoints
+     * @param segments Segment lookup of the axis
+     * @param reciprocals Reciprocals of the axis segment widths
+     * @param value The input value, clamped to the axis
+     * @param[out] fraction Position inside the segment, 0 at the lower breakpoint and FRACTION_ONE at the upper one
+     * @return Index of the upper breakpoint of the segment
+     */
+    template <typename T, uint8_t size>
+    static constexpr uint8_t locate(const T (&axis)[size], const SegmentIndex<T, T, size> &segments,
+                                    const uint32_t (&reciprocals)[size - 1], const T value, uint16_t &fraction)
+    {
+        if (value <= axis[0])
+        {
+            fraction = 0;
+            return 1;
+        }
+        if (value >= axis[size - 1])
+        {
+            fraction = FRACTION_ONE;
+            return size - 1;
+        }
+        const uint8_t i = segments.find(axis, value);
+        const uint32_t offset = static_cast<uint16_t>(value - axis[i - 1]);
+        fraction = static_cast<uint16_t>((offset * reciprocals[i - 1] + (static_cast<uint32_t>(1) << (RECIPROCAL_EXTRA_BITS - 1))) >> RECIPROCAL_EXTRA_BITS);
+        return i;
+    }
+
+    /**
+     * @brief Linear interpolation between two values
+     * @param from Value at fraction 0
+     * @param to Value at FRACTION_ONE
+     * @param fraction Q14 position between the values
+     * @return The interpolated value
+     */
+    static constexpr Tmid lerp(const Tmid from, const Tmid to, const uint16_t fraction)
+    {
+        return from + (((to - from) * static_cast<Tmid>(fraction) + (static_cast<Tmid>(1) << (FRACTION_BITS - 1))) >> FRACTION_BITS);
+    }
+};
+
+/**
+ * @brief Class template for a dense lookup table, expanded from a LinearInterp at compile time
+ * @details Every input from 0 to LUT_SIZE - 1 is evaluated with LinearInterp::interp() by the compiler,
+ * so a lookup is a single indexed flash read instead of a segment scan and a 32-bit divide.
+ * Costs LUT_SIZE * 2 bytes of flash, e.g. 2KB for a 10-bit ADC input.
+ * For inputs with more bits than the table, INPUT_SHIFT drops the low bits: entry i holds interp(i << INPUT_SHIFT),
+ * so the output steps every 2^INPUT_SHIFT inputs instead of matching interp() exactly.
+ * Objects must be defined constexpr with PROGMEM, as lookup() reads through pgm_read_word.
+ * Inputs at or above LUT_SIZE << INPUT_SHIFT are clamped to the last entry, so the table's last input point should be below that.
+ * @tparam Tout Type of the output values, must be 16-bit
+ * @tparam LUT_SIZE Number of entries in the table, 1024 for a 10-bit ADC
+ * @tparam INPUT_SHIFT Input bits dropped before the lookup, 0 for one entry per input value
+ */
+template <typename Tout, uint16_t LUT_SIZE, uint8_t INPUT_SHIFT = 0>
+class FlashLut
+{
+    static_assert(sizeof(Tout) == 2, "FlashLut reads with pgm_read_word, Tout must be 16-bit");
+
+public:
+    FlashLut() = delete; /**< Default constructor deleted to prevent instantiation without a map */
+
+    /**
+     * @brief Expands the given LinearInterp into the table, only meant to be evaluated at compile time
+     * @param map The LinearInterp to expand
+     */
+    template <typename Tin, typename Tmid, uint8_t size>
+    explicit constexpr FlashLut(const LinearInterp<Tin, Tout, Tmid, size> &map) : lut{}
+    {
+        for (uint16_t i = 0; i < LUT_SIZE; ++i)
+            lut[i] = map.interp(static_cast<Tin>(static_cast<uint32_t>(i) << INPUT_SHIFT));
+    }
+
+    /**
+     * @brief Looks up the output value for the given input, object must be in PROGMEM
+     * @param input The input value, clamped to (LUT_SIZE << INPUT_SHIFT) - 1
+     * @return The output value, identical to LinearInterp::interp() of the source map at input with the low INPUT_SHIFT bits cleared
+     */
+    Tout lookup(uint16_t input) const
+    {
+        input >>= INPUT_SHIFT;
+        if (input >= LUT_SIZE)
+            input = LUT_SIZE - 1;
+        return static_cast<Tout>(pgm_read_word(&lut[input]));
+    }
+
+private:
+    Tout lut[LUT_SIZE]; /**< Expanded table, one entry per input value */
+};
+
+/**
+ * @brief Class template for a dense lookup table of x axis positions of a BilinearInterp, expanded at compile time
+ * @details The FlashLut of a 2D map: entry i holds BilinearInterp::locateX(i << INPUT_SHIFT), so only the y axis is searched per call.
+ * Costs LUT_SIZE * 3 bytes of flash, e.g. 3KB for a 10-bit ADC input, and the same input bits as FlashLut are dropped.
+ * Objects must be defined constexpr with PROGMEM, as lookup() reads through pgm_read_word and pgm_read_byte.
+ * @tparam LUT_SIZE Number of entries in the table, 1024 for a 10-bit ADC
+ * @tparam INPUT_SHIFT Input bits dropped before the lookup, 0 for one entry per input value
+ */
+template <uint16_t LUT_SIZE, uint8_t INPUT_SHIFT = 0>
+class FlashAxisLut
+{
+public:
+    FlashAxisLut() = delete; /**< Default constructor deleted to prevent instantiation without a map */
+
+    /**
+     * @brief Expands the x axis of the given BilinearInterp into the table, only meant to be evaluated at compile time
+     * @param map The BilinearInterp to expand
+     */
+    template <typename Tx, typename Ty, typename Tout, typename Tmid, uint8_t size_x, uint8_t size_y>
+    explicit constexpr FlashAxisLut(const BilinearInterp<Tx, Ty, Tout, Tmid, size_x, size_y> &map) : fractions{}, indices{}
+    {
+        for (uint16_t i = 0; i < LUT_SIZE; ++i)
+        {
+            const AxisPosition position = map.locateX(static_cast<Tx>(static_cast<uint32_t>(i) << INPUT_SHIFT));
+            fractions[i] = position.fraction;
+            indices[i] = position.index;
+        }
+    }
+
+    /**
+     * @brief Looks up the x axis position of the given input, object must be in PROGMEM
+     * @param input The input value, clamped to (LUT_SIZE << INPUT_SHIFT) - 1
+     * @return The position, identical to BilinearInterp::locateX() of the source map at input with the low INPUT_SHIFT bits cleared
+     */
+    AxisPosition lookup(uint16_t input) const
+    {
+        input >>= INPUT_SHIFT;
+        if (input >= LUT_SIZE)
+            input = LUT_SIZE - 1;
+        return AxisPosition{static_cast<uint8_t>(pgm_read_byte(&indices[input])), static_cast<uint16_t>(pgm_read_word(&fractions[input]))};
+    }
+
 private:
-    const TablePoint<Tin, Tout> (&table)[size]; /**< Reference to the interpolation table */
+    uint16_t fractions[LUT_SIZE]; /**< Position inside the segment of each input value */
+    uint8_t indices[LUT_SIZE];    /**< Upper breakpoint of the segment of each input value */
 };
 
 #endif // INTERP_HPP
\ No newline at end of file
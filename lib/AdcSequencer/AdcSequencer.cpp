@@ -0,0 +1,139 @@
+/**
+ * @file AdcSequencer.cpp
+ * @author Planeson, Red Bird Racing
+ * @brief Implementation of the AdcSequencer class
+ * @version 1.1
+ * @date 2026-10-16
+ * @see AdcSequencer.hpp
+ */
+
+#include "AdcSequencer.hpp"
+
+AdcSequencer *AdcSequencer::instance = nullptr;
+
+/**
+ * @brief ADC conversion complete interrupt, services the running AdcSequencer.
+ */
+ISR(ADC_vect)
+{
+    AdcSequencer::handleInterrupt();
+}
+
+/**
+ * @brief Starts the conversions.
+ * Takes over the ADC: AVcc reference, ADC clock F_CPU / 128 (125kHz at 16MHz), conversion complete interrupt.
+ * Turns off the digital input buffers of the channels that have one, the pins are analog only from here on.
+ * Call once in setup(), after which analogRead must not be used.
+ */
+void AdcSequencer::begin()
+{
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        if (channels[i] < 6) // ADC6 and ADC7 have no digital input
+            DIDR0 |= _BV(channels[i]);
+    }
+    noInterrupts();
+    instance = this;
+    index = 0;
+    settling = count > 1; // a single channel never switches the mux
+    sum = 0;
+    remaining = samples(0);
+    ADMUX = _BV(REFS0) | channels[0];
+    ADCSRB = 0;
+    ADCSRA = _BV(ADEN) | _BV(ADIE) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0) | _BV(ADIF); // writing ADIF clears a stale flag
+    ADCSRA |= _BV(ADSC);
+    interrupts();
+}
+
+/**
+ * @brief Reads the latest conversion of an input without blocking.
+ * Retries if the interrupt wrote the value while it was being read.
+ * @param index Index of the input in the pins given to the constructor.
+ * @return Latest value, 10 bits plus the oversample bits of the input, 0 before the first round completes.
+ */
+uint16_t AdcSequencer::read(const uint8_t index) const
+{
+    uint8_t before;
+    uint16_t value;
+    do
+    {
+        before = updates[index];
+        value = latest[index];
+    } while (before != updates[index]);
+    return value;
+}
+
+/**
+ * @brief Checks if every input has been converted again since the last call.
+ * @return true once per completed round, false otherwise.
+ */
+bool AdcSequencer::newRound()
+{
+    const uint8_t now = rounds;
+    if (now == last_round)
+        return false;
+    last_round = now;
+    return true;
+}
+
+/**
+ * @brief Number of conversions in one round, thrown away ones included.
+ * A round takes conversionsPerRound() * ADC_CONVERSION_US.
+ * @return Sum over the inputs of 4^oversample bits, plus one settling conversion per input if there are several.
+ */
+uint16_t AdcSequencer::conversionsPerRound() const
+{
+    uint16_t conversions = 0;
+    for (uint8_t i = 0; i < count; ++i)
+        conversions += samples(i) + (count > 1);
+    return conversions;
+}
+
+/**
+ * @brief Called from the ADC interrupt, forwards to the running sequencer.
+ */
+void AdcSequencer::handleInterrupt()
+{
+    if (instance != nullptr)
+        instance->isr();
+}
+
+/**
+ * @brief Adds a finished conversion to the sum, stores the decimated sum once the input has all its conversions,
+ * then switches the mux to the next input and starts the next conversion.
+ * The conversion right after a mux switch is only started, not added.
+ */
+void AdcSequencer::isr()
+{
+    const uint16_t value = ADC;
+    if (settling)
+    {
+        settling = false;
+        ADCSRA |= _BV(ADSC);
+        return;
+    }
+
+    const uint8_t i = index;
+    const uint16_t total = sum + value;
+    const uint8_t left = remaining - 1;
+    if (left != 0)
+    {
+        ADCSRA |= _BV(ADSC); // same input, no settling needed
+        sum = total;
+        remaining = left;
+        return;
+    }
+
+    latest[i] = total >> oversample[i];
+    updates[i] = updates[i] + 1;
+
+    const uint8_t next = (i + 1 == count) ? 0 : i + 1;
+    if (next == 0)
+        rounds = rounds + 1;
+    index = next;
+    settling = count > 1;
+    sum = 0;
+    remaining = samples(next);
+    ADMUX = _BV(REFS0) | channels[next];
+    ADCSRA |= _BV(ADSC);
+}
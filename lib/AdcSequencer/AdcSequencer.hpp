@@ -0,0 +1,113 @@
+/**
+ * @file AdcSequencer.hpp
+ * @author Planeson, Red Bird Racing
+ * @brief Declaration of the AdcSequencer class, interrupt-driven conversions of the analog inputs
+ * @version 1.2
+ * @date 2026-10-16
+ * @see AdcSequencer.cpp
+ * @dir AdcSequencer @brief The AdcSequencer library contains the AdcSequencer class, which converts the analog inputs in the background from the ADC interrupt, replacing blocking analogRead calls.
+ */
+
+#ifndef ADC_SEQUENCER_HPP
+#define ADC_SEQUENCER_HPP
+
+#include <Arduino.h>
+#include <stdint.h>
+
+constexpr uint8_t ADC_MAX_CHANNELS = 8;       /**< Number of external ADC mux channels on the ATmega328P */
+constexpr uint8_t ADC_MAX_OVERSAMPLE_BITS = 3; /**< Most extra bits per input, 4^3 10-bit conversions still fit the 16-bit sum */
+constexpr uint16_t ADC_CONVERSION_US = 13UL * 128 * 1000000 / F_CPU; /**< Duration of one conversion, 13 ADC clocks at F_CPU / 128 */
+
+/**
+ * @brief Converts an Arduino analog pin number to its ADC mux channel, as analogRead does.
+ * @param pin Analog pin, e.g. PIN_A6 or PIN_PC0.
+ * @return ADC mux channel, 0-7.
+ */
+constexpr uint8_t adcChannel(const uint8_t pin)
+{
+    return pin >= PIN_A0 ? pin - PIN_A0 : pin;
+}
+
+/**
+ * @brief Converts a list of analog inputs over and over from the ADC complete interrupt.
+ * @details Each conversion complete interrupt stores the result and starts the next conversion, so the ADC never waits for loop().
+ * The first conversion after each mux switch is thrown away, as the sample and hold capacitor is still charged to the previous channel
+ * through the source impedance of the sensor. With the ADC clock at 125kHz a conversion takes 104us (ADC_CONVERSION_US),
+ * and a round takes conversionsPerRound() of them: N * 208us for N plain inputs, 51 conversions or about 5.3ms for the
+ * three pedal inputs at 16x oversampling. The round time sets the rate of the pedal filters.
+ *
+ * Inputs can be oversampled: with n extra bits, 4^n conversions in a row are summed and the sum shifted right by n,
+ * which gives a (10 + n)-bit value, as long as there is at least 1 LSB of noise on the input to dither it.
+ * The interrupt rate stays one per conversion whatever the oversampling, so the CPU cost per second doesn't change,
+ * only the round rate drops, see conversionsPerRound().
+ *
+ * Each channel has a latest value and an update counter, written only by the interrupt.
+ * read() is lock-free: it reads the counter, the value, and the counter again, and retries if the interrupt ran in between,
+ * so a 16-bit value can't be torn without turning off interrupts.
+ * newRound() tells loop() when every channel has a new value, so the filters run at the ADC round rate whatever the loop rate.
+ *
+ * Only one AdcSequencer can be running, and analogRead must not be used once begin() is called, it would change the mux.
+ */
+class AdcSequencer
+{
+public:
+    /**
+     * @brief Constructor for AdcSequencer, plain 10-bit conversions.
+     * @tparam N Number of inputs, at most ADC_MAX_CHANNELS.
+     * @param pins Analog pins to convert, read() takes the index in this list.
+     */
+    template <uint8_t N>
+    explicit AdcSequencer(const uint8_t (&pins)[N])
+        : count(N)
+    {
+        static_assert(N > 0 && N <= ADC_MAX_CHANNELS, "AdcSequencer takes 1 to ADC_MAX_CHANNELS pins");
+        for (uint8_t i = 0; i < N; ++i)
+            channels[i] = adcChannel(pins[i]);
+    }
+
+    /**
+     * @brief Constructor for AdcSequencer with oversampled inputs.
+     * @tparam N Number of inputs, at most ADC_MAX_CHANNELS.
+     * @param pins Analog pins to convert, read() takes the index in this list.
+     * @param oversample_bits Extra bits of each input, clamped to ADC_MAX_OVERSAMPLE_BITS; 0 is a single 10-bit conversion.
+     */
+    template <uint8_t N>
+    AdcSequencer(const uint8_t (&pins)[N], const uint8_t (&oversample_bits)[N])
+        : AdcSequencer(pins)
+    {
+        for (uint8_t i = 0; i < N; ++i)
+            oversample[i] = oversample_bits[i] > ADC_MAX_OVERSAMPLE_BITS ? ADC_MAX_OVERSAMPLE_BITS : oversample_bits[i];
+    }
+
+    void begin();
+    uint16_t read(uint8_t index) const;
+    bool newRound();
+    uint16_t conversionsPerRound() const;
+    static void handleInterrupt();
+
+private:
+    uint8_t channels[ADC_MAX_CHANNELS] = {};   /**< ADC mux channel of each input */
+    uint8_t oversample[ADC_MAX_CHANNELS] = {}; /**< Extra bits of each input */
+    const uint8_t count;                       /**< Number of inputs */
+
+    volatile uint16_t latest[ADC_MAX_CHANNELS] = {}; /**< Latest conversion of each input, written by the interrupt */
+    volatile uint8_t updates[ADC_MAX_CHANNELS] = {}; /**< Incremented by the interrupt after each write to latest, for lock-free reads */
+    volatile uint8_t rounds = 0;                     /**< Incremented by the interrupt after the last input of each round */
+    volatile uint8_t index = 0;                      /**< Input being converted */
+    volatile bool settling = false;                  /**< Whether the conversion running is the one thrown away after a mux switch */
+    volatile uint16_t sum = 0;                       /**< Sum of the conversions of the input so far, only touched by the interrupt */
+    volatile uint8_t remaining = 0;                  /**< Conversions of the input still to add to sum */
+    uint8_t last_round = 0;                          /**< Value of rounds at the last newRound() returning true */
+
+    static AdcSequencer *instance; /**< Sequencer serviced by the ADC interrupt, set by begin() */
+
+    /**
+     * @brief Number of conversions summed for an input.
+     * @param input Index of the input.
+     * @return 4^oversample[input]
+     */
+    uint8_t samples(const uint8_t input) const { return static_cast<uint8_t>(1u << (2 * oversample[input])); }
+    void isr();
+};
+
+#endif // ADC_SEQUENCER_HPP
@@ -2,8 +2,8 @@
  * @file BMS.cpp
  * @author Planeson, Chiho, Red Bird Racing
  * @brief Implementation of the BMS class for managing the Accumulator (Kclear BMS) via CAN bus
- * @version 1.4
- * @date 2026-02-25
+ * @version 1.8
+ * @date 2026-10-16
  * @see BMS.hpp
  */
 
@@ -27,10 +27,11 @@
 /**
  * @brief Construct a new BMS object, initing car.pedal.status.bits.hv_ready to false
  * @param bms_can_ Reference to MCP2515 for BMS CAN bus
+ * @param bms_tx_ Reference to the TX queue of bms_can_, the HV commands are sent directly through it
  * @param car_ Reference to CarState, for the status flags and setting BMS data
  */
-BMS::BMS(MCP2515 &bms_can_, CarState &car_)
-    : bms_can(bms_can_), car(car_)
+BMS::BMS(MCP2515 &bms_can_, CanTxQueue &bms_tx_, CarState &car_)
+    : bms_can(bms_can_), bms_tx(bms_tx_), car(car_)
 {
     car.pedal.status.bits.hv_ready = false;
 }
@@ -58,18 +59,27 @@ void BMS::initFilter()
  * Keep sending the command until the BMS state changes to precharge(4).
  * Sets car.pedal.status.bits.hv_ready to true when BMS state changes to run(5).
  *
+ * Empties the receive buffers, counting overflows into car.can, and acts on the latest BMS info frame, see readFrame.
+ *
+ * @param rx_pending false if the MCP2515 has nothing received (e.g. its INT line is high), skips the SPI read.
+ * @param rx_buffers Receive buffers of the BMS bus, see canDrainRx, only RXB0 if the MCP2515 is shared with Command.
+ * @return true if a BMS info frame was received, false if there was none or HV is already started.
  */
-void BMS::checkHv()
+bool BMS::checkHv(const bool rx_pending, const uint8_t rx_buffers)
 {
     car.pedal.status.bits.bms_no_msg = false;
     if (car.pedal.status.bits.hv_ready)
-    return; // already started
+    return false; // already started
     car.pedal.status.bits.hv_ready = false;
-    if (bms_can.readMessage(&rx_bms_msg) == MCP2515::ERROR_NOMSG)
+    if (rx_pending)
+        canDrainRx(bms_can, rx_buffers, car.can.rx_overruns[static_cast<uint8_t>(McpIndex::Bms)],
+                   [this](const can_frame &rx_frame) { readFrame(rx_frame); });
+    if (!rx_bms_new)
     {
         car.pedal.status.bits.bms_no_msg = true;
-        return;
+        return false;
     }
+    rx_bms_new = false;
 
     /* now that we set filter on MCP2515, it's impossible to get wrong ID
     // Check if the BMS is in standby state (0x3 in upper 4 bits)
@@ -83,20 +93,34 @@ void BMS::checkHv()
     switch (rx_bms_msg.data[6] & 0xF0)
     {
     case 0x30: // Standby state
-        bms_can.sendMessage(&start_hv_msg);
+        bms_tx.sendDirect(start_hv_msg);
         DBGLN_GENERAL("BMS in standby state, sent start HV cmd");
         // sent start HV cmd, wait for BMS to change state
-        return;
+        return true;
     case 0x40: // Precharge state
-        bms_can.sendMessage(&start_hv_msg);
+        bms_tx.sendDirect(start_hv_msg);
         DBGLN_GENERAL("BMS in precharge state, HV starting");
-        return; // BMS is in precharge state, wait
+        return true; // BMS is in precharge state, wait
     case 0x50:  // Run state
         DBGLN_GENERAL("BMS in run state, HV started");
         car.pedal.status.bits.hv_ready = true; // BMS is in run state
-        return;
+        return true;
     default:
         DBGLN_GENERAL("BMS in unknown state, retrying...");
-        return; // Unknown state, retry
+        return true; // Unknown state, retry
     }
 }
+
+/**
+ * @brief Keeps a frame received on the BMS bus for checkHv, if it is a BMS info frame.
+ * Called by checkHv, and for frames rolled over into RXB1 when the MCP2515 is shared with Command,
+ * where the frames of the other buses also arrive.
+ * @param rx_frame Received frame.
+ */
+void BMS::readFrame(const can_frame &rx_frame)
+{
+    if (rx_frame.can_id != BMS_INFO_EXT)
+        return;
+    rx_bms_msg = rx_frame;
+    rx_bms_new = true;
+}
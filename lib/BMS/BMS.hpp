@@ -2,8 +2,8 @@
  * @file BMS.hpp
  * @author Planeson, Red Bird Racing
  * @brief Declaration of the BMS class for managing the Accumulator (Kclear BMS) via CAN bus
- * @version 1.2
- * @date 2026-02-04
+ * @version 1.6
+ * @date 2026-10-16
  * @see BMS.cpp
  * @dir BMS @brief The BMS library contains the BMS class for managing the Accumulator (Kclear BMS) via CAN bus, including starting HV and checking BMS status.
  */
@@ -13,6 +13,8 @@
 
 #include "Scheduler.hpp"
 #include "CarState.hpp"
+#include "CanRx.hpp"
+#include "CanTx.hpp"
 
 // ignore -Wpedantic warnings for mcp2515.h
 #pragma GCC diagnostic push
@@ -46,23 +48,26 @@ constexpr can_frame stop_hv_msg = {
 class BMS
 {
 public:
-    BMS(MCP2515 &bms_can_, CarState &car_);
+    BMS(MCP2515 &bms_can_, CanTxQueue &bms_tx_, CarState &car_);
     /**
      * @brief Returns true if HV has been started
      * @return true if HV started, false otherwise
      */
     bool hvReady() const { return car.pedal.status.bits.hv_ready; };
     void initFilter();
-    void checkHv();
+    bool checkHv(bool rx_pending = true, uint8_t rx_buffers = CAN_RX_ALL_BUFFERS);
+    void readFrame(const can_frame &rx_frame);
 
 private:
-    MCP2515 &bms_can; /**< Reference to MCP2515 for BMS CAN bus */
+    MCP2515 &bms_can;   /**< Reference to MCP2515 for BMS CAN bus */
+    CanTxQueue &bms_tx; /**< Reference to the TX queue of bms_can, for the HV commands */
     /** Local storage for received BMS CAN frame */
     can_frame rx_bms_msg = {
         0,   /**< can_id */
         0,   /**< can_dlc */
         {0}, /**< data */
     };
-    CarState &car;       /**< Reference to CarState, for the status flags and setting BMS data */
+    bool rx_bms_new = false; /**< Flag indicating rx_bms_msg was received since checkHv last acted on it */
+    CarState &car;           /**< Reference to CarState, for the status flags and setting BMS data */
 };
 #endif // BMS_HPP
\ No newline at end of file
@@ -0,0 +1,152 @@
+/**
+ * @file Calibration.cpp
+ * @author Planeson, Red Bird Racing
+ * @brief Implementation of the Calibration class for tuning the pedal maps live and saving them to EEPROM
+ * @version 1.2
+ * @date 2026-10-16
+ * @see Calibration.hpp
+ */
+
+#include "Calibration.hpp"
+#include <avr/eeprom.h> // EEMEM, eeprom_read_block, eeprom_update_block
+#include <util/crc16.h> // _crc16_update
+#include <stddef.h>     // offsetof
+
+CalibrationRecord Calibration::eeprom_record EEMEM;
+
+/**
+ * @brief Construct a new Calibration object, with nothing being edited
+ * @param pedal_ Reference to Pedal, for reading and loading the maps
+ * @param car_ Reference to CarState, EEPROM access is refused in Drive
+ */
+Calibration::Calibration(Pedal &pedal_, CarState &car_)
+    : pedal(pedal_), car(car_), edit(), editing(false)
+{
+}
+
+/**
+ * @brief Starts editing from the maps in use.
+ * Calling again drops any unapplied writes.
+ * @return CalibrationResult::Ok
+ */
+CalibrationResult Calibration::begin()
+{
+    edit = pedal.getMaps();
+    editing = true;
+    return CalibrationResult::Ok;
+}
+
+/**
+ * @brief Writes one point of the throttle or regen grid in the edit buffer.
+ * Not validated until apply(), so a curve can be reshaped one point at a time.
+ * @param table CalibrationTable::Throttle or CalibrationTable::Regen.
+ * @param row RPM row of the grid.
+ * @param column APPS or brake column of the grid.
+ * @param value Torque at that point.
+ * @return CalibrationResult::Ok, NotEditing without begin(), or BadIndex.
+ */
+CalibrationResult Calibration::writeGrid(const CalibrationTable table, const uint8_t row, const uint8_t column, const int16_t value)
+{
+    if (!editing)
+        return CalibrationResult::NotEditing;
+    if (row >= TORQUE_GRID_RPM_POINTS || column >= TORQUE_GRID_PEDAL_POINTS)
+        return CalibrationResult::BadIndex;
+    switch (table)
+    {
+    case CalibrationTable::Throttle:
+        edit.profile.throttle[row][column] = value;
+        return CalibrationResult::Ok;
+    case CalibrationTable::Regen:
+        edit.profile.regen[row][column] = value;
+        return CalibrationResult::Ok;
+    default:
+        return CalibrationResult::BadIndex;
+    }
+}
+
+/**
+ * @brief Writes one point of the APPS_3V3 scale table in the edit buffer, switching it from APPS_3V3_SCALE_TABLE to the edited table.
+ * @param point Index of the point.
+ * @param in APPS_3V3 ADC of the point, ADC_BITS.
+ * @param out Matching APPS_5V ADC, ADC_BITS.
+ * @return CalibrationResult::Ok, NotEditing without begin(), or BadIndex.
+ */
+CalibrationResult Calibration::writeApps3v3Scale(const uint8_t point, const uint16_t in, const uint16_t out)
+{
+    if (!editing)
+        return CalibrationResult::NotEditing;
+    if (point >= APPS_3V3_SCALE_POINTS)
+        return CalibrationResult::BadIndex;
+    edit.apps_3v3_scale[point] = {in, out};
+    edit.apps_3v3_scale_calibrated = true;
+    return CalibrationResult::Ok;
+}
+
+/**
+ * @brief Validates the edit buffer and hands it to Pedal, which swaps it in once the pedals are released.
+ * Editing can continue afterwards for the next apply().
+ * @return CalibrationResult::Ok, NotEditing without begin(), or Invalid if Pedal rejected the maps.
+ */
+CalibrationResult Calibration::apply()
+{
+    if (!editing)
+        return CalibrationResult::NotEditing;
+    return pedal.loadMaps(edit) ? CalibrationResult::Ok : CalibrationResult::Invalid;
+}
+
+/**
+ * @brief Saves the maps in use to EEPROM, to be loaded at boot.
+ * Only changed bytes are written, but a full write still blocks for a few hundred ms, so this is refused in Drive.
+ * @return CalibrationResult::Ok, or NotAllowed in Drive.
+ */
+CalibrationResult Calibration::commit()
+{
+    if (car.pedal.status.bits.car_status == CarStatus::Drive)
+        return CalibrationResult::NotAllowed;
+    CalibrationRecord record;
+    record.magic = CALIBRATION_MAGIC;
+    record.maps = pedal.getMaps();
+    record.crc = crc(record);
+    eeprom_update_block(&record, &eeprom_record, sizeof(CalibrationRecord));
+    return CalibrationResult::Ok;
+}
+
+/**
+ * @brief Invalidates the EEPROM record, so the next boot uses the flash tables.
+ * The maps in use are kept until then.
+ * @return CalibrationResult::Ok, or NotAllowed in Drive.
+ */
+CalibrationResult Calibration::erase()
+{
+    if (car.pedal.status.bits.car_status == CarStatus::Drive)
+        return CalibrationResult::NotAllowed;
+    eeprom_update_word(&eeprom_record.magic, 0xFFFF);
+    return CalibrationResult::Ok;
+}
+
+/**
+ * @brief Loads the EEPROM record into Pedal if there is a valid one, call once in setup().
+ * @return CalibrationResult::Ok, NoRecord if never committed or corrupted, or Invalid if Pedal rejected the maps.
+ */
+CalibrationResult Calibration::load()
+{
+    CalibrationRecord record;
+    eeprom_read_block(&record, &eeprom_record, sizeof(CalibrationRecord));
+    if (record.magic != CALIBRATION_MAGIC || record.crc != crc(record))
+        return CalibrationResult::NoRecord;
+    return pedal.loadMaps(record.maps) ? CalibrationResult::Ok : CalibrationResult::Invalid;
+}
+
+/**
+ * @brief Computes the CRC-16 of a record, excluding the crc field itself.
+ * @param record The record.
+ * @return CRC-16 (polynomial 0xA001) over magic and maps.
+ */
+uint16_t Calibration::crc(const CalibrationRecord &record)
+{
+    const uint8_t *const bytes = reinterpret_cast<const uint8_t *>(&record);
+    uint16_t result = 0xFFFF;
+    for (uint8_t i = 0; i < offsetof(CalibrationRecord, crc); ++i)
+        result = _crc16_update(result, bytes[i]);
+    return result;
+}
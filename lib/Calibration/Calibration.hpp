@@ -0,0 +1,62 @@
+/**
+ * @file Calibration.hpp
+ * @author Planeson, Red Bird Racing
+ * @brief Declaration of the Calibration class for tuning the pedal maps live and saving them to EEPROM
+ * @version 1.1
+ * @date 2026-10-16
+ * @see Calibration.cpp
+ * @dir Calibration @brief The Calibration library contains the Calibration class, which edits a copy of the pedal maps, hands validated copies to Pedal, and keeps one copy in EEPROM to load at boot.
+ */
+
+#ifndef CALIBRATION_HPP
+#define CALIBRATION_HPP
+
+#include <stdint.h>
+#include "Enums.hpp"
+#include "CarState.hpp"
+#include "Pedal.hpp"
+
+/**
+ * @brief Layout of the pedal maps in EEPROM
+ */
+struct CalibrationRecord
+{
+    uint16_t magic; /**< CALIBRATION_MAGIC if written, changes with the size of PedalMaps and ADC_BITS so old layouts and units aren't loaded */
+    PedalMaps maps; /**< The saved maps */
+    uint16_t crc;   /**< CRC-16 of magic and maps */
+};
+
+/**
+ * @brief Calibration class for tuning the pedal maps without reflashing
+ * Writes go into an edit buffer owned by this class; Pedal only ever gets a complete, validated copy through Pedal::loadMaps,
+ * which it swaps in at a tick boundary. The torque path keeps reading its own RAM copy, so it is as fast as with the flash profiles.
+ *
+ * Usage: begin(), any number of writeGrid()/writeApps3v3Scale(), apply(), check on the car, then commit() to keep it across power cycles.
+ */
+class Calibration
+{
+public:
+    Calibration(Pedal &pedal_, CarState &car_);
+    CalibrationResult begin();
+    CalibrationResult writeGrid(CalibrationTable table, uint8_t row, uint8_t column, int16_t value);
+    CalibrationResult writeApps3v3Scale(uint8_t point, uint16_t in, uint16_t out);
+    CalibrationResult apply();
+    CalibrationResult commit();
+    CalibrationResult erase();
+    CalibrationResult load();
+
+private:
+    static constexpr uint16_t CALIBRATION_MAGIC = 0xC000 | (ADC_BITS << 8) | sizeof(PedalMaps); /**< Marks a written record, 0xCA.. for 10-bit tables, see CalibrationRecord::magic */
+    static_assert(sizeof(PedalMaps) < 0x100, "CALIBRATION_MAGIC holds the size of PedalMaps in its low byte");
+    static_assert(ADC_BITS < 0x10, "CALIBRATION_MAGIC holds ADC_BITS in its second nibble");
+
+    static CalibrationRecord eeprom_record; /**< The record in EEPROM, only accessed through eeprom_*() */
+
+    Pedal &pedal;   /**< Reference to Pedal, for reading and loading the maps */
+    CarState &car;  /**< Reference to CarState, EEPROM access is refused in Drive */
+    PedalMaps edit; /**< Edit buffer, not used by Pedal until apply() */
+    bool editing;   /**< Flag indicating begin() was called and edit holds a full set of maps */
+
+    static uint16_t crc(const CalibrationRecord &record);
+};
+#endif // CALIBRATION_HPP
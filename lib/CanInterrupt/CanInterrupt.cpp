@@ -0,0 +1,85 @@
+/**
+ * @file CanInterrupt.cpp
+ * @author Planeson, Red Bird Racing
+ * @brief Implementation of the CanInterrupt class
+ * @version 1.0
+ * @date 2026-10-16
+ * @see CanInterrupt.hpp
+ */
+
+#include "CanInterrupt.hpp"
+
+// the first wired INT line decides the port of the interrupt
+#if INT_CAN_MOTOR != 0xFF
+#define CAN_INT_PORT_PIN INT_CAN_MOTOR
+#elif INT_CAN_BMS != 0xFF
+#define CAN_INT_PORT_PIN INT_CAN_BMS
+#elif INT_CAN_DL != 0xFF
+#define CAN_INT_PORT_PIN INT_CAN_DL
+#endif
+
+#if defined(__AVR__) && defined(CAN_INT_PORT_PIN)
+#include <Arduino.h>
+
+// pin change interrupt vector of the INT port, PCINT0 for PB, PCINT1 for PC, PCINT2 for PD
+#if CAN_INT_PORT_PIN < 8
+#define CAN_INT_PCINT_vect PCINT2_vect
+#elif CAN_INT_PORT_PIN < 14
+#define CAN_INT_PCINT_vect PCINT0_vect
+#else
+#define CAN_INT_PCINT_vect PCINT1_vect
+#endif
+
+/**
+ * @brief Checks that an INT line can share the interrupt.
+ * @param pin INT_CAN_* pin.
+ * @return true if not wired, or on the port of the interrupt and not on the HALL_SENSOR port.
+ */
+constexpr bool canIntPinValid(const uint8_t pin)
+{
+    return pin == CAN_INT_NONE || (pinRegister(pin) == pinRegister(CAN_INT_PORT_PIN) && pinRegister(pin) != pinRegister(HALL_SENSOR));
+}
+static_assert(canIntPinValid(INT_CAN_MOTOR) && canIntPinValid(INT_CAN_BMS) && canIntPinValid(INT_CAN_DL),
+              "INT_CAN_* must be on one port, other than the HALL_SENSOR port");
+
+/**
+ * @brief Pin change interrupt of the INT lines, only wakes the MCU, CanIntPin reads the lines.
+ */
+EMPTY_INTERRUPT(CAN_INT_PCINT_vect);
+
+/**
+ * @brief Makes a wired INT line an input and sets its bit in the pin change mask.
+ * @tparam PIN INT_CAN_* pin, or CAN_INT_NONE to do nothing.
+ */
+template <uint8_t PIN>
+static void enableLine()
+{
+    if (PIN == CAN_INT_NONE)
+        return;
+    constexpr uint8_t LINE = PIN == CAN_INT_NONE ? 0 : PIN;
+    FastPin<LINE>::input(); // driven by the MCP2515
+    *digitalPinToPCMSK(LINE) |= _BV(digitalPinToPCMSKbit(LINE));
+}
+
+/**
+ * @brief Turns on the pin change interrupt of the wired INT lines.
+ * Call once in setup(), after the MCP2515s are reset and configured.
+ */
+void CanInterrupt::begin()
+{
+    noInterrupts();
+    enableLine<INT_CAN_MOTOR>();
+    enableLine<INT_CAN_BMS>();
+    enableLine<INT_CAN_DL>();
+    PCIFR = _BV(digitalPinToPCICRbit(CAN_INT_PORT_PIN)); // writing a 1 clears a stale flag
+    PCICR |= _BV(digitalPinToPCICRbit(CAN_INT_PORT_PIN));
+    interrupts();
+}
+#else
+/**
+ * @brief No INT line wired, CAN RX is polled, nothing to start.
+ */
+void CanInterrupt::begin()
+{
+}
+#endif // __AVR__ && CAN_INT_PORT_PIN
@@ -0,0 +1,87 @@
+/**
+ * @file CanInterrupt.hpp
+ * @author Planeson, Red Bird Racing
+ * @brief Declaration of the CanIntPin class template and CanInterrupt class, the MCP2515 INT lines for event-driven CAN RX
+ * @version 1.0
+ * @date 2026-10-16
+ * @see CanInterrupt.cpp, BoardConfig.h
+ * @dir CanInterrupt @brief The CanInterrupt library watches the INT lines of the MCP2515s, so their receive buffers are only read over SPI when a frame has arrived.
+ */
+
+#ifndef CAN_INTERRUPT_HPP
+#define CAN_INTERRUPT_HPP
+
+#include <stdint.h>
+#include "BoardConfig.h"
+#include "FastPin.hpp"
+
+// ignore -Wpedantic warnings for mcp2515.h
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#include <mcp2515.h>
+#pragma GCC diagnostic pop
+
+constexpr uint8_t CAN_INT_NONE = 0xFF; /**< INT_CAN_* of an MCP2515 whose INT line isn't wired to the MCU */
+
+// INT lines not given in BoardConfig.h are not wired, CAN_INT_NONE, kept as a literal for the #if in CanInterrupt.cpp
+#ifndef INT_CAN_MOTOR
+#define INT_CAN_MOTOR 0xFF
+#endif
+#ifndef INT_CAN_BMS
+#define INT_CAN_BMS 0xFF
+#endif
+#ifndef INT_CAN_DL
+#define INT_CAN_DL 0xFF
+#endif
+
+/**
+ * @brief INT line of one MCP2515, read instead of asking the controller over SPI whether a frame has arrived.
+ * @details MCP2515::reset() enables the RX0IF, RX1IF, ERRIF and MERRF interrupts, and INT stays low while any of their flags is set.
+ * readMessage() clears the RX flag of the buffer it reads, so INT goes back high once both receive buffers are empty.
+ * A frame arriving while the other one is read keeps it low, so the level is checked rather than edges counted, and no frame is missed.
+ * ERRIF and MERRF aren't cleared by reading, release() clears them when INT was low with no frame to read.
+ *
+ * Without the line (PIN is CAN_INT_NONE), pending() is always true, so the caller polls every time as before.
+ * All functions are static, use it through an alias, e.g. using MotorCanInt = CanIntPin<INT_CAN_MOTOR>;
+ * @tparam PIN Arduino pin number of the INT line from BoardConfig.h, or CAN_INT_NONE.
+ */
+template <uint8_t PIN>
+class CanIntPin
+{
+public:
+    static constexpr bool WIRED = PIN != CAN_INT_NONE; /**< Whether the INT line is wired */
+
+    /**
+     * @brief Checks if the MCP2515 may have a received frame, a single pin read.
+     * @return true if INT is low, always true if not WIRED.
+     */
+    static bool pending() { return !WIRED || !FastPin<WIRED ? PIN : 0>::read(); }
+
+    /**
+     * @brief Clears the error interrupt flags holding INT low, call when pending() was true but there was no frame.
+     * Does nothing if not WIRED, polling doesn't need it.
+     * @param mcp MCP2515 the line belongs to.
+     */
+    static void release(MCP2515 &mcp)
+    {
+        if (!WIRED)
+            return;
+        mcp.clearERRIF();
+        mcp.clearMERR();
+    }
+};
+
+/**
+ * @brief Pin change interrupt on the wired INT_CAN_* lines, waking the MCU when a frame arrives.
+ * @details The interrupt itself does nothing, CanIntPin::pending() reads the lines. It wakes the MCU out of TimerClock::sleepIdle,
+ * so loop() runs right after a frame arrives instead of at the next scheduler tick.
+ * The INT lines must all be on one port, not the HALL_SENSOR one, whose interrupt belongs to HallSensor.
+ * Without any INT line wired, nothing is compiled in.
+ */
+class CanInterrupt
+{
+public:
+    static void begin();
+};
+
+#endif // CAN_INTERRUPT_HPP
@@ -0,0 +1,74 @@
+/**
+ * @file CanRx.hpp
+ * @author Planeson, Red Bird Racing
+ * @brief Definition of canDrainRx, emptying the MCP2515 receive buffers with overflow accounting
+ * @version 1.0
+ * @date 2026-10-16
+ * @see CarState.hpp, CanInterrupt.hpp
+ * @dir CanRx @brief The CanRx library contains canDrainRx, which reads every frame waiting in an MCP2515 and counts the frames lost to receive buffer overflows.
+ */
+
+#ifndef CAN_RX_HPP
+#define CAN_RX_HPP
+
+#include <stdint.h>
+
+// ignore -Wpedantic warnings for mcp2515.h
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#include <mcp2515.h>
+#pragma GCC diagnostic pop
+
+constexpr uint8_t CAN_RX_MAX_ROUNDS = 2;                                                  /**< CANINTF reads per canDrainRx call at most, so a busy bus can't hold up the loop */
+constexpr uint8_t CAN_RX_ALL_BUFFERS = MCP2515::CANINTF_RX0IF | MCP2515::CANINTF_RX1IF; /**< Both receive buffers, for a bus with the MCP2515 to itself */
+
+/**
+ * @brief Reads every frame waiting in the given receive buffers of an MCP2515, and counts receive buffer overflows.
+ * @details A round reads CANINTF, then each of the buffers with its RXnIF set. If every one of them had a frame,
+ * more may have arrived meanwhile, so CANINTF is read again, up to CAN_RX_MAX_ROUNDS rounds.
+ * A frame arriving while its buffer is still full is lost, setting RX0OVR or RX1OVR in EFLG and ERRIF in CANINTF.
+ * EFLG is only read when ERRIF is set: the overflow flags are counted, then cleared along with ERRIF, which also releases INT.
+ * The overflow flags belong to the MCP2515, a caller sharing it with another bus counts the overflows of both.
+ * @tparam HANDLER Callable taking the received const can_frame &.
+ * @param mcp MCP2515 to read.
+ * @param buffers MCP2515::CANINTF_RX0IF and/or MCP2515::CANINTF_RX1IF, the receive buffers of the caller.
+ * @param overruns Overflow counter of the bus, one per flag found set, saturated at UINT16_MAX.
+ * @param handler Called with every frame read, RXB0 before RXB1 in each round, the older frame first as the driver enables rollover.
+ * @return Number of frames read.
+ */
+template <typename HANDLER>
+uint8_t canDrainRx(MCP2515 &mcp, const uint8_t buffers, uint16_t &overruns, HANDLER handler)
+{
+    can_frame frame;
+    uint8_t frames = 0;
+    for (uint8_t round = 0; round < CAN_RX_MAX_ROUNDS; ++round)
+    {
+        const uint8_t flags = mcp.getInterrupts();
+        if (flags & MCP2515::CANINTF_ERRIF)
+        {
+            const uint8_t eflg = mcp.getErrorFlags();
+            const uint8_t lost = ((eflg & MCP2515::EFLG_RX0OVR) ? 1 : 0) + ((eflg & MCP2515::EFLG_RX1OVR) ? 1 : 0);
+            if (lost != 0)
+                mcp.clearRXnOVRFlags();
+            mcp.clearERRIF();
+            overruns = overruns > UINT16_MAX - lost ? UINT16_MAX : overruns + lost;
+        }
+
+        const uint8_t full = flags & buffers;
+        if ((full & MCP2515::CANINTF_RX0IF) && mcp.readMessage(MCP2515::RXB0, &frame) == MCP2515::ERROR_OK)
+        {
+            handler(frame);
+            ++frames;
+        }
+        if ((full & MCP2515::CANINTF_RX1IF) && mcp.readMessage(MCP2515::RXB1, &frame) == MCP2515::ERROR_OK)
+        {
+            handler(frame);
+            ++frames;
+        }
+        if (full != buffers)
+            break; // a buffer was empty, nothing was waiting behind the frames read
+    }
+    return frames;
+}
+
+#endif // CAN_RX_HPP
@@ -0,0 +1,117 @@
+/**
+ * @file CanTx.cpp
+ * @author Planeson, Red Bird Racing
+ * @brief Implementation of the CanTxQueue class
+ * @version 1.1
+ * @date 2026-10-16
+ * @see CanTx.hpp
+ */
+
+#include "CanTx.hpp"
+
+/**
+ * @brief Queues a frame, replacing the unsent one with the same CAN ID, then sends what the free TX buffers take.
+ * When the queue is full, the oldest frame that isn't urgent is dropped for it. If all are urgent, a frame that isn't is dropped itself.
+ * @param frame Frame to send
+ * @param urgent true to send it in TXB2, the highest priority TX buffer, e.g. the torque command
+ */
+void CanTxQueue::send(const can_frame &frame, const bool urgent)
+{
+    uint8_t index = 0;
+    while (index < count && slots[index].frame.can_id != frame.can_id)
+        ++index;
+
+    if (index < count)
+    {
+        slots[index].urgent = slots[index].urgent || urgent;
+        if (coalesced != UINT16_MAX)
+            ++coalesced;
+    }
+    else
+    {
+        if (count == CAN_TX_QUEUE_SIZE)
+        {
+            if (dropped != UINT16_MAX)
+                ++dropped;
+            uint8_t oldest = 0;
+            while (oldest < count && slots[oldest].urgent)
+                ++oldest;
+            if (oldest == count)
+            {
+                if (!urgent)
+                    return;
+                oldest = 0;
+            }
+            remove(oldest);
+        }
+        index = count++;
+        slots[index].urgent = urgent;
+    }
+    slots[index].frame = frame;
+    flush();
+}
+
+/**
+ * @brief Sends a frame straight into TXB0 or TXB1 without queueing it, for frames that must not replace others of the same CAN ID.
+ * Never uses TXB2, which stays free for the urgent frames. Costs one SPI read of READ STATUS before the frame.
+ * @param frame Frame to send
+ * @return MCP2515::ERROR_OK if sent, MCP2515::ERROR_ALLTXBUSY if TXB0 and TXB1 both have a frame pending, the caller retries
+ */
+MCP2515::ERROR CanTxQueue::sendDirect(const can_frame &frame)
+{
+    const uint8_t status = mcp.getStatus();
+    if (!(status & CAN_TX_STAT_TX0REQ))
+        return mcp.sendMessage(MCP2515::TXB0, &frame);
+    if (!(status & CAN_TX_STAT_TX1REQ))
+        return mcp.sendMessage(MCP2515::TXB1, &frame);
+    return MCP2515::ERROR_ALLTXBUSY;
+}
+
+/**
+ * @brief Sends the queued frames, oldest first, into the TX buffers that are free.
+ * Frames left waiting are retried on the next send() or flush(), call once a tick so they go out on the next one.
+ * Costs one SPI read of READ STATUS, nothing more if no buffer is free.
+ */
+void CanTxQueue::flush()
+{
+    if (count == 0)
+        return;
+    uint8_t status = mcp.getStatus();
+    uint8_t index = 0;
+    while (index < count)
+    {
+        // sendMessage() reports FAILTX if arbitration was lost right away, the frame is still pending and retried by the MCP2515
+        if (slots[index].urgent && !(status & CAN_TX_STAT_TX2REQ))
+        {
+            mcp.sendMessage(MCP2515::TXB2, &slots[index].frame);
+            status |= CAN_TX_STAT_TX2REQ;
+        }
+        else if (!slots[index].urgent && !(status & CAN_TX_STAT_TX0REQ))
+        {
+            mcp.sendMessage(MCP2515::TXB0, &slots[index].frame);
+            status |= CAN_TX_STAT_TX0REQ;
+        }
+        else if (!slots[index].urgent && !(status & CAN_TX_STAT_TX1REQ))
+        {
+            mcp.sendMessage(MCP2515::TXB1, &slots[index].frame);
+            status |= CAN_TX_STAT_TX1REQ;
+        }
+        else
+        {
+            ++index;
+            continue;
+        }
+        remove(index);
+    }
+}
+
+/**
+ * @brief Removes a slot, keeping the others oldest first
+ * @param index Slot to remove
+ */
+void CanTxQueue::remove(const uint8_t index)
+{
+    for (uint8_t i = index + 1; i < count; ++i)
+        slots[i - 1] = slots[i];
+    --count;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file CanTx.hpp
+ * @author Planeson, Red Bird Racing
+ * @brief Declaration of the CanTxQueue class, a latest-value-wins transmit queue for an MCP2515
+ * @version 1.1
+ * @date 2026-10-16
+ * @see CanTx.cpp
+ * @dir CanTx @brief The CanTx library contains the CanTxQueue class, holding the frames an MCP2515 had no free transmit buffer for until the next try, one slot per CAN ID.
+ */
+
+#ifndef CAN_TX_HPP
+#define CAN_TX_HPP
+
+#include <stdint.h>
+
+// ignore -Wpedantic warnings for mcp2515.h
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#include <mcp2515.h>
+#pragma GCC diagnostic pop
+
+constexpr uint8_t CAN_TX_QUEUE_SIZE = 4; /**< Frames waiting per MCP2515 at most, each with its own CAN ID */
+
+// READ STATUS bits of MCP2515::getStatus(), the driver keeps its own enum private
+constexpr uint8_t CAN_TX_STAT_TX0REQ = 0x04; /**< TXB0 has a frame pending */
+constexpr uint8_t CAN_TX_STAT_TX1REQ = 0x10; /**< TXB1 has a frame pending */
+constexpr uint8_t CAN_TX_STAT_TX2REQ = 0x40; /**< TXB2 has a frame pending */
+
+/**
+ * @brief Transmit queue of an MCP2515, newer data replacing older unsent data of the same CAN ID.
+ * Frames go straight to a free TX buffer if there is one, else wait in a slot of the queue until flush() finds one.
+ * Urgent frames (the torque command) only use TXB2, which the MCP2515 sends first as all buffers are left at the same TXP,
+ * the others only TXB0 and TXB1, so telemetry can't hold a torque command back in the hardware.
+ * Only queue frames whose ID identifies their content: the motor's register reads share MOTOR_SEND with the torque command, so they go through sendDirect().
+ * Frames sent with MCP2515::sendMessage(&frame) may take TXB2, so every frame on an MCP2515 with a queue goes through send() or sendDirect().
+ * The constructor is constexpr, so a queue no bus uses is dropped by the linker.
+ */
+class CanTxQueue
+{
+public:
+    /**
+     * @brief Construct a new CanTxQueue object
+     * @param mcp_ Reference to the MCP2515 to send on
+     */
+    constexpr explicit CanTxQueue(MCP2515 &mcp_)
+        : mcp(mcp_), slots{}, count(0), dropped(0), coalesced(0)
+    {
+    }
+    void send(const can_frame &frame, bool urgent = false);
+    MCP2515::ERROR sendDirect(const can_frame &frame);
+    void flush();
+    /**
+     * @brief Returns the number of frames waiting for a TX buffer
+     * @return Frames in the queue
+     */
+    uint8_t getPending() const { return count; }
+    /**
+     * @brief Returns the number of frames lost to a full queue, saturating
+     * @return Dropped frames
+     */
+    uint16_t getDropped() const { return dropped; }
+    /**
+     * @brief Returns the number of unsent frames replaced by newer data of the same CAN ID, saturating
+     * @return Coalesced frames
+     */
+    uint16_t getCoalesced() const { return coalesced; }
+
+private:
+    /**
+     * @brief A frame waiting for a TX buffer
+     */
+    struct Slot
+    {
+        can_frame frame; /**< Latest data for its CAN ID */
+        bool urgent;     /**< Sent in TXB2 */
+    };
+
+    MCP2515 &mcp;                  /**< Reference to the MCP2515 to send on */
+    Slot slots[CAN_TX_QUEUE_SIZE]; /**< Waiting frames, oldest first */
+    uint8_t count;                 /**< Number of slots in use */
+    uint16_t dropped;              /**< Frames lost to a full queue */
+    uint16_t coalesced;            /**< Frames replaced before being sent */
+
+    void remove(uint8_t index);
+};
+
+#endif // CAN_TX_HPP
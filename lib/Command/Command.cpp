@@ -0,0 +1,120 @@
+/**
+ * @file Command.cpp
+ * @author Planeson, Red Bird Racing
+ * @brief Implementation of the Command class for receiving commands over the datalogger CAN bus
+ * @version 1.4
+ * @date 2026-10-16
+ * @see Command.hpp
+ */
+
+#include "Command.hpp"
+
+/**
+ * @brief Construct a new Command object
+ * @param dl_can_ Reference to MCP2515 for the datalogger CAN bus
+ * @param dl_tx_ Reference to the TX queue of dl_can_, for the calibration replies
+ * @param car_ Reference to CarState, for the receive overflow count
+ * @param pedal_ Reference to Pedal, for selecting the torque profile
+ * @param calibration_ Reference to Calibration, for the calibration commands
+ * @param rollover_fn Called with the frames rolled over into RXB1 from RXB0, to pass them to the module sharing the MCP2515, nullptr if not shared
+ */
+Command::Command(MCP2515 &dl_can_, CanTxQueue &dl_tx_, CarState &car_, Pedal &pedal_, Calibration &calibration_, void (*const rollover_fn)(const can_frame &))
+    : dl_can(dl_can_), dl_tx(dl_tx_), car(car_), pedal(pedal_), calibration(calibration_), ROLLOVER_FN(rollover_fn)
+{
+}
+
+/**
+ * @brief Initializes the CAN filters for receiving commands into RXB1.
+ * Call after constructing the Command object and the MCP2515 object it references.
+ * This function will block until the filter is set correctly on the MCP2515, same as Pedal::initFilter.
+ */
+void Command::initFilter()
+{
+    dl_can.setConfigMode();
+    while (dl_can.setFilterMask(MCP2515::MASK1, false, 0x7FF) != MCP2515::ERROR_OK)
+        ;
+    while (dl_can.setFilter(MCP2515::RXF2, false, COMMAND_PROFILE_MSG) != MCP2515::ERROR_OK)
+        ;
+    while (dl_can.setFilter(MCP2515::RXF3, false, COMMAND_CAL_WRITE_MSG) != MCP2515::ERROR_OK)
+        ;
+    while (dl_can.setFilter(MCP2515::RXF4, false, COMMAND_CAL_CTRL_MSG) != MCP2515::ERROR_OK)
+        ;
+    dl_can.setNormalMode();
+}
+
+/**
+ * @brief Reads the commands in RXB1 and applies them, counting receive overflows of the datalogger bus into car.can.
+ */
+void Command::read()
+{
+    canDrainRx(dl_can, MCP2515::CANINTF_RX1IF, car.can.rx_overruns[static_cast<uint8_t>(McpIndex::Datalogger)],
+               [this](const can_frame &rx_frame) { apply(rx_frame); });
+}
+
+/**
+ * @brief Applies a received command, answering calibration commands with COMMAND_CAL_ACK_MSG.
+ * Frames rolled over from RXB0 also land in RXB1, so the ID is checked again, and other frames go to ROLLOVER_FN.
+ * @param rx_frame Frame read from RXB1.
+ */
+void Command::apply(const can_frame &rx_frame)
+{
+    if (rx_frame.can_id == COMMAND_PROFILE_MSG && rx_frame.can_dlc > 0)
+    {
+        pedal.selectProfile(static_cast<TorqueProfileId>(rx_frame.data[0]));
+        return;
+    }
+    if (rx_frame.can_id != COMMAND_CAL_WRITE_MSG && rx_frame.can_id != COMMAND_CAL_CTRL_MSG)
+    {
+        if (ROLLOVER_FN != nullptr)
+            ROLLOVER_FN(rx_frame);
+        return;
+    }
+
+    const can_frame ack_frame = {
+        COMMAND_CAL_ACK_MSG, /**< can_id */
+        4,                   /**< can_dlc */
+        rx_frame.data[0],    /**< data, echo of the command */
+        rx_frame.data[1],
+        rx_frame.data[2],
+        static_cast<__u8>(calibrate(rx_frame))}; /**< data, CalibrationResult */
+    dl_tx.sendDirect(ack_frame);
+}
+
+/**
+ * @brief Decodes a calibration write or control frame and runs it.
+ * @param rx_frame Frame with COMMAND_CAL_WRITE_MSG or COMMAND_CAL_CTRL_MSG.
+ * @return Result to acknowledge with, BadIndex if the frame is too short or names an unknown table or action.
+ */
+CalibrationResult Command::calibrate(const can_frame &rx_frame)
+{
+    if (rx_frame.can_id == COMMAND_CAL_WRITE_MSG)
+    {
+        const CalibrationTable table = static_cast<CalibrationTable>(rx_frame.data[0]);
+        const uint16_t value = static_cast<uint16_t>(rx_frame.data[3] | (rx_frame.data[4] << 8));
+        if (table == CalibrationTable::Apps3v3Scale)
+        {
+            if (rx_frame.can_dlc < 7)
+                return CalibrationResult::BadIndex;
+            return calibration.writeApps3v3Scale(rx_frame.data[2], value, static_cast<uint16_t>(rx_frame.data[5] | (rx_frame.data[6] << 8)));
+        }
+        if (rx_frame.can_dlc < 5)
+            return CalibrationResult::BadIndex;
+        return calibration.writeGrid(table, rx_frame.data[1], rx_frame.data[2], static_cast<int16_t>(value));
+    }
+
+    if (rx_frame.can_dlc < 1)
+        return CalibrationResult::BadIndex;
+    switch (static_cast<CalibrationAction>(rx_frame.data[0]))
+    {
+    case CalibrationAction::Begin:
+        return calibration.begin();
+    case CalibrationAction::Apply:
+        return calibration.apply();
+    case CalibrationAction::Commit:
+        return calibration.commit();
+    case CalibrationAction::Erase:
+        return calibration.erase();
+    default:
+        return CalibrationResult::BadIndex;
+    }
+}
@@ -0,0 +1,57 @@
+/**
+ * @file Command.hpp
+ * @author Planeson, Red Bird Racing
+ * @brief Declaration of the Command class for receiving commands over the datalogger CAN bus
+ * @version 1.4
+ * @date 2026-10-16
+ * @see Command.cpp
+ * @dir Command @brief The Command library contains the Command class for receiving commands from the pit over the datalogger CAN bus, such as selecting the torque profile and calibrating the pedal maps.
+ */
+
+#ifndef COMMAND_HPP
+#define COMMAND_HPP
+
+#include "Pedal.hpp"
+#include "Calibration.hpp"
+#include "CarState.hpp"
+#include "CanRx.hpp"
+#include "CanTx.hpp"
+
+// ignore -Wpedantic warnings for mcp2515.h
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#include <mcp2515.h>
+#pragma GCC diagnostic pop
+
+constexpr canid_t COMMAND_PROFILE_MSG = 0x720;   /**< Command: select torque profile, data[0] is the TorqueProfileId */
+constexpr canid_t COMMAND_CAL_WRITE_MSG = 0x721; /**< Command: calibration write, data[0] CalibrationTable, data[1] row, data[2] column or point, data[3-4] value or input, data[5-6] output, little endian */
+constexpr canid_t COMMAND_CAL_CTRL_MSG = 0x722;  /**< Command: calibration control, data[0] CalibrationAction */
+constexpr canid_t COMMAND_CAL_ACK_MSG = 0x723;   /**< Reply to every calibration command, data[0-2] echo the command, data[3] CalibrationResult */
+
+/**
+ * @brief Command class for receiving commands over the datalogger CAN bus
+ * Commands are received into RXB1 only, through MASK1 and RXF2-RXF5,
+ * leaving MASK0 and RXB0 to whichever module shares the MCP2515.
+ * RXB1 holds a single frame, so calibration tools must wait for each COMMAND_CAL_ACK_MSG before sending the next command.
+ * The driver enables rollover, so a frame arriving while RXB0 is full also lands in RXB1;
+ * those are handed to the rollover function, for the module sharing the MCP2515 to read.
+ */
+class Command
+{
+public:
+    Command(MCP2515 &dl_can_, CanTxQueue &dl_tx_, CarState &car_, Pedal &pedal_, Calibration &calibration_, void (*const rollover_fn)(const can_frame &) = nullptr);
+    void initFilter();
+    void read();
+
+private:
+    MCP2515 &dl_can;          /**< Reference to MCP2515 for the datalogger CAN bus */
+    CanTxQueue &dl_tx;        /**< Reference to the TX queue of dl_can, for the calibration replies */
+    CarState &car;            /**< Reference to CarState, for the receive overflow count */
+    Pedal &pedal;             /**< Reference to Pedal, for selecting the torque profile */
+    Calibration &calibration; /**< Reference to Calibration, for the calibration commands */
+    void (*const ROLLOVER_FN)(const can_frame &); /**< Called with the frames in RXB1 that aren't commands, nullptr to drop them */
+
+    void apply(const can_frame &rx_frame);
+    CalibrationResult calibrate(const can_frame &rx_frame);
+};
+#endif // COMMAND_HPP
@@ -2,8 +2,8 @@
  * @file Debug_can.cpp
  * @author Planeson, Chiho, Red Bird Racing
  * @brief Implementation of the Debug_CAN namespace for CAN debugging functions
- * @version 2.0
- * @date 2026-02-25
+ * @version 2.1
+ * @date 2026-10-16
  * @see Debug_can.hpp
  */
 
@@ -15,15 +15,15 @@
 #include <mcp2515.h>
 #pragma GCC diagnostic pop
 
-MCP2515 *Debug_CAN::can_interface = nullptr;
+CanTxQueue *Debug_CAN::can_interface = nullptr;
 
 /**
  * @brief Initializes the Debug_CAN interface.
  * It should be called before using any other Debug_CAN functions.
  * 
- * @param can Pointer to the MCP2515 CAN controller instance.
+ * @param can Pointer to the TX queue of the MCP2515 CAN controller instance, debug messages never take TXB2 from the torque command.
  */
-void Debug_CAN::initialize(MCP2515 *can)
+void Debug_CAN::initialize(CanTxQueue *can)
 {
     if (can == nullptr)
         return;
@@ -70,5 +70,5 @@ void Debug_CAN::send_message(
     tx_msg.data[6] = data6;
     tx_msg.data[7] = data7;
 
-    can_interface->sendMessage(&tx_msg);
+    can_interface->sendDirect(tx_msg);
 }
\ No newline at end of file
@@ -2,19 +2,15 @@
  * @file Debug_can.hpp
  * @author Planeson, Chiho, Red Bird Racing
  * @brief Declaration of the Debug_CAN namespace for CAN debugging functions
- * @version 2.0.1
- * @date 2026-03-04
+ * @version 2.1.0
+ * @date 2026-10-16
  * @see Debug_can.cpp
  */
 
 #ifndef DEBUG_CAN_HPP
 #define DEBUG_CAN_HPP
 
-// ignore -Wpedantic warnings for mcp2515.h
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wpedantic"
-#include <mcp2515.h>
-#pragma GCC diagnostic pop
+#include "CanTx.hpp"
 
 #include "Enums.hpp"
 
@@ -23,9 +19,9 @@
  */
 namespace Debug_CAN
 {
-    extern MCP2515 *can_interface; /**< Pointer to the MCP2515 CAN controller instance. */
+    extern CanTxQueue *can_interface; /**< Pointer to the TX queue of the MCP2515 CAN controller instance. */
 
-    void initialize(MCP2515 *can_interface);
+    void initialize(CanTxQueue *can_interface);
 
 
     void send_message(
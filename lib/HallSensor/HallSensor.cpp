@@ -0,0 +1,127 @@
+/**
+ * @file HallSensor.cpp
+ * @author Planeson, Red Bird Racing
+ * @brief Implementation of the HallSensor class
+ * @version 1.0
+ * @date 2026-10-16
+ * @see HallSensor.hpp
+ */
+
+#include "HallSensor.hpp"
+
+HallSensor *HallSensor::instance = nullptr;
+
+#ifdef __AVR__
+#include <Arduino.h>
+#include "BoardConfig.h"
+#include "FastPin.hpp"
+
+// pin change interrupt vector of the HALL_SENSOR port, PCINT0 for PB, PCINT1 for PC, PCINT2 for PD
+#if HALL_SENSOR < 8
+#define HALL_PCINT_vect PCINT2_vect
+#elif HALL_SENSOR < 14
+#define HALL_PCINT_vect PCINT0_vect
+#else
+#define HALL_PCINT_vect PCINT1_vect
+#endif
+
+/**
+ * @brief Pin change interrupt of the HALL_SENSOR port, services the running HallSensor.
+ */
+ISR(HALL_PCINT_vect)
+{
+    HallSensor::handleInterrupt();
+}
+
+/**
+ * @brief Starts timing the edges.
+ * Makes HALL_SENSOR a digital input and turns on its pin change interrupt.
+ * The pin must not be in the AdcSequencer inputs, those have their digital input buffer turned off.
+ * Call once in setup().
+ */
+void HallSensor::begin()
+{
+    FastPin<HALL_SENSOR>::input();
+    noInterrupts();
+    instance = this;
+    *digitalPinToPCMSK(HALL_SENSOR) |= _BV(digitalPinToPCMSKbit(HALL_SENSOR));
+    PCIFR = _BV(digitalPinToPCICRbit(HALL_SENSOR)); // writing a 1 clears a stale flag
+    PCICR |= _BV(digitalPinToPCICRbit(HALL_SENSOR));
+    interrupts();
+}
+
+/**
+ * @brief Called from the pin change interrupt, passes rising edges to the running sensor.
+ * The interrupt fires on both edges, and on any other pin of the port with its PCMSK bit set, so the pin level is checked.
+ */
+void HallSensor::handleInterrupt()
+{
+    if (instance != nullptr && FastPin<HALL_SENSOR>::read())
+        instance->edge(micros());
+}
+#endif // __AVR__
+
+/**
+ * @brief Records a rising edge, called from the interrupt.
+ * Edges within HALL_MIN_PERIOD_US of the last one are dropped as noise.
+ * @param now_us Time of the edge, micros().
+ */
+void HallSensor::edge(const uint32_t now_us)
+{
+    if (edges != 0 && now_us - last_edge_us < HALL_MIN_PERIOD_US)
+        return;
+    last_edge_us = now_us;
+    edges = edges + 1;
+}
+
+/**
+ * @brief Measures the period over the edges since the last call and converts it to wheel RPM.
+ * Call periodically, at least once per HALL_TIMEOUT_US, outside the interrupt.
+ * @param now_us Current time, micros().
+ * @return Wheel RPM, rounded, 0 if standing still or before two edges.
+ */
+uint16_t HallSensor::update(const uint32_t now_us)
+{
+    // lock-free snapshot, the interrupt writes last_edge_us before edges
+    uint16_t count;
+    uint32_t last;
+    do
+    {
+        count = edges;
+        last = last_edge_us;
+    } while (count != edges);
+
+    const uint16_t new_edges = count - window_edges;
+    if (new_edges != 0)
+    {
+        const uint32_t span = last - window_start_us;
+        // over HALL_TIMEOUT_US per edge the wheel stopped in between, the cap keeps span << 4 inside 32 bits
+        const uint32_t max_span = HALL_TIMEOUT_US * (new_edges < 64 ? new_edges : 64);
+        if (moving && span < max_span)
+            period = (span << HALL_PERIOD_FRACTION_BITS) / new_edges;
+        else
+            period = 0; // first edge after standing still, the next one gives the period
+        moving = true;
+        window_start_us = last;
+        window_edges = count;
+    }
+    else if (moving)
+    {
+        const uint32_t since = now_us - window_start_us;
+        if (since >= HALL_TIMEOUT_US)
+        {
+            moving = false;
+            period = 0;
+        }
+        else if (period != 0 && (since << HALL_PERIOD_FRACTION_BITS) > period)
+        {
+            period = since << HALL_PERIOD_FRACTION_BITS; // the next edge is at least this far away, slowing down
+        }
+    }
+
+    if (period == 0)
+        return 0;
+    const uint32_t divisor = period * HALL_PULSES_PER_REV;
+    const uint32_t rpm = (HALL_RPM_NUMERATOR + divisor / 2) / divisor;
+    return rpm > UINT16_MAX ? UINT16_MAX : static_cast<uint16_t>(rpm);
+}
@@ -0,0 +1,58 @@
+/**
+ * @file HallSensor.hpp
+ * @author Planeson, Red Bird Racing
+ * @brief Declaration of the HallSensor class, wheel speed from the hall sensor edge timing
+ * @version 1.0
+ * @date 2026-10-16
+ * @see HallSensor.cpp
+ * @dir HallSensor @brief The HallSensor library contains the HallSensor class, which timestamps the hall sensor edges in a pin change interrupt and turns them into wheel RPM.
+ */
+
+#ifndef HALL_SENSOR_HPP
+#define HALL_SENSOR_HPP
+
+#include <stdint.h>
+
+constexpr uint8_t HALL_PULSES_PER_REV = 1;         /**< Rising edges per wheel revolution, one per magnet or tooth passing the sensor */
+constexpr uint32_t HALL_MIN_PERIOD_US = 2000;      /**< Edges closer than this after the last one are noise, 30000 RPM / HALL_PULSES_PER_REV */
+constexpr uint32_t HALL_TIMEOUT_US = 1000000;      /**< No edge for this long reads as standing still, below 60 RPM / HALL_PULSES_PER_REV */
+constexpr uint8_t HALL_PERIOD_FRACTION_BITS = 4;   /**< Fraction bits of the period, 1/16us, so averaging edges keeps sub-microsecond resolution */
+constexpr uint32_t HALL_RPM_NUMERATOR = 60000000UL << HALL_PERIOD_FRACTION_BITS; /**< RPM = HALL_RPM_NUMERATOR / (period * HALL_PULSES_PER_REV) */
+static_assert(HALL_TIMEOUT_US < (1UL << (32 - HALL_PERIOD_FRACTION_BITS)), "HALL_TIMEOUT_US must fit the fixed-point period");
+
+/**
+ * @brief Measures wheel speed from the rising edges of the hall sensor.
+ * @details The pin change interrupt only stores the time of the edge and counts it, see edge().
+ * update() runs outside the interrupt, e.g. once per scheduler tick: it takes the edges since the last call
+ * and averages their period over that window, so the RPM resolution gets better the more edges there are per call.
+ * With no new edge, the time since the last one is a lower bound of the period, so the reading falls smoothly
+ * when the wheel stops instead of holding the last value, and reads 0 after HALL_TIMEOUT_US.
+ *
+ * Only one HallSensor can be running, it owns the pin change interrupt of the HALL_SENSOR port.
+ */
+class HallSensor
+{
+public:
+    void begin();
+    void edge(uint32_t now_us);
+    uint16_t update(uint32_t now_us);
+    /**
+     * @brief Returns the period measured by the last update().
+     * @return Period between rising edges in 1/16us, 0 if not moving.
+     */
+    uint32_t getPeriod() const { return period; }
+    static void handleInterrupt();
+
+private:
+    volatile uint32_t last_edge_us = 0; /**< Time of the last accepted edge, written by the interrupt */
+    volatile uint16_t edges = 0;        /**< Accepted edges so far, written by the interrupt after last_edge_us */
+
+    uint32_t window_start_us = 0; /**< Time of the last edge seen by update(), start of the next window */
+    uint16_t window_edges = 0;    /**< Value of edges at the last update() */
+    bool moving = false;          /**< Whether window_start_us is recent enough to measure from */
+    uint32_t period = 0;          /**< Last measured period in 1/16us, 0 if not moving */
+
+    static HallSensor *instance; /**< Sensor serviced by the pin change interrupt, set by begin() */
+};
+
+#endif // HALL_SENSOR_HPP
@@ -2,8 +2,8 @@
  * @file Pedal.cpp
  * @author Planeson, Chiho, Red Bird Racing
  * @brief Implementation of the Pedal class for handling throttle pedal inputs
- * @version 1.7
- * @date 2026-02-25
+ * @version 1.24
+ * @date 2026-10-16
  * @see Pedal.hpp
  */
 
@@ -22,24 +22,58 @@
 #include "Debug.hpp" // DBGLN_GENERAL
 #pragma GCC diagnostic pop
 
+// === Dense flash tables ===
+// unused tables are dropped by the linker (--gc-sections) when their *_MAP_MODE isn't MapMode::FlashLut
+
+static_assert(THROTTLE_TABLE[4].in < (static_cast<uint32_t>(ADC_LUT_SIZE) << ADC_OVERSAMPLE_BITS), "THROTTLE_TABLE must end inside the LUT for clamping to match interp()");
+static_assert(BRAKE_TABLE[4].in < (static_cast<uint32_t>(ADC_LUT_SIZE) << ADC_OVERSAMPLE_BITS), "BRAKE_TABLE must end inside the LUT for clamping to match interp()");
+static_assert(APPS_3V3_SCALE_TABLE[2].in < (static_cast<uint32_t>(ADC_LUT_SIZE) << ADC_OVERSAMPLE_BITS), "APPS_3V3_SCALE_TABLE must end inside the LUT for clamping to match interp()");
+static_assert(THROTTLE_APPS_AXIS[4] < (static_cast<uint32_t>(ADC_LUT_SIZE) << ADC_OVERSAMPLE_BITS), "THROTTLE_APPS_AXIS must end inside the LUT for clamping to match locateX()");
+static_assert(REGEN_BRAKE_AXIS[4] < (static_cast<uint32_t>(ADC_LUT_SIZE) << ADC_OVERSAMPLE_BITS), "REGEN_BRAKE_AXIS must end inside the LUT for clamping to match locateX()");
+
+constexpr FlashLut<int16_t, ADC_LUT_SIZE, ADC_OVERSAMPLE_BITS> Pedal::THROTTLE_LUT PROGMEM{THROTTLE_MAP};
+constexpr FlashLut<int16_t, ADC_LUT_SIZE, ADC_OVERSAMPLE_BITS> Pedal::BRAKE_LUT PROGMEM{BRAKE_MAP};
+constexpr FlashLut<uint16_t, ADC_LUT_SIZE, ADC_OVERSAMPLE_BITS> Pedal::APPS_3V3_SCALE_LUT PROGMEM{APPS_3V3_SCALE_MAP};
+constexpr FlashAxisLut<ADC_LUT_SIZE, ADC_OVERSAMPLE_BITS> Pedal::THROTTLE_AXIS_LUT PROGMEM{THROTTLE_RPM_MAP};
+constexpr FlashAxisLut<ADC_LUT_SIZE, ADC_OVERSAMPLE_BITS> Pedal::REGEN_AXIS_LUT PROGMEM{REGEN_RPM_MAP};
+
+// === Torque profiles ===
+
+constexpr TorqueProfile Pedal::PROFILES[TORQUE_PROFILE_COUNT] PROGMEM = {
+    ENDURANCE_PROFILE,    // TorqueProfileId::Endurance
+    ACCELERATION_PROFILE, // TorqueProfileId::Acceleration
+    SKIDPAD_PROFILE};     // TorqueProfileId::Skidpad
+
 /**
  * @brief Constructor for the Pedal class.
  * Initializes the pedal state. fault is set to true initially,
  * so you must send update within 100ms of starting the car to clear it.
  * Call the initMotor function to set up the motor CAN filters and cyclic reads after constructing the Pedal object and the MCP2515 object it references.
  * @param motor_can_ Reference to the MCP2515 instance for motor CAN communication.
+ * @param motor_tx_ Reference to the TX queue of motor_can_, the torque command is sent through it in TXB2, the cyclic read requests directly.
  * @param car_ Reference to the CarState structure.
  * @param pedal_final_ Reference to the pedal used as the final pedal value. Although not recommended, you can set another uint16 outside Pedal to be something like 0.3 APPS_1 + 0.7 APPS_2, then reference that here. If in future, this become a sustained need, should consider adding a function pointer to find the final pedal value to let Pedal class call it itself.
  */
-Pedal::Pedal(MCP2515 &motor_can_, CarState &car_, uint16_t &pedal_final_)
+Pedal::Pedal(MCP2515 &motor_can_, CanTxQueue &motor_tx_, CarState &car_, uint16_t &pedal_final_)
     : pedal_final(pedal_final_),
       car(car_),
       motor_can(motor_can_),
+      motor_tx(motor_tx_),
       fault_start_millis(0),
       last_motor_read_millis(0),
       got_speed(false),
-      got_error(false)
+      got_error(false),
+      active_maps(&map_buffers[0]),
+      pending_profile(TorqueProfileId::Endurance),
+      maps_pending(false),
+      apps_3v3_scale_interps{Apps3v3ScaleInterp{map_buffers[0].apps_3v3_scale}, Apps3v3ScaleInterp{map_buffers[1].apps_3v3_scale}}
 {
+    memcpy_P(&map_buffers[0].profile, &PROFILES[static_cast<uint8_t>(TorqueProfileId::Endurance)], sizeof(TorqueProfile));
+    for (uint8_t i = 0; i < APPS_3V3_SCALE_POINTS; ++i)
+        map_buffers[0].apps_3v3_scale[i] = APPS_3V3_SCALE_TABLE[i];
+    map_buffers[0].apps_3v3_scale_calibrated = false;
+    apps_3v3_scale_interps[0] = Apps3v3ScaleInterp{map_buffers[0].apps_3v3_scale};
+    car.pedal.torque_profile = TorqueProfileId::Endurance;
 }
 
 /**
@@ -89,7 +123,8 @@ bool Pedal::initMotor()
 /**
  * @brief Updates pedal sensor readings, applies filtering, and checks for faults.
  *
- * Stores new pedal readings, applies an average filter, and updates car state.
+ * Stores new pedal readings, applies the median and exponential filters, and updates car state.
+ * Range checks use the median, so a single-sample spike can't latch a fault.
  * If a fault is detected between pedal sensors, sets fault flags and logs status.
  *
  * @param pedal_1 Raw value from pedal sensor 1.
@@ -98,10 +133,12 @@ bool Pedal::initMotor()
  */
 void Pedal::update(uint16_t pedal_1, uint16_t pedal_2, uint16_t brake)
 {
-    // Add new samples to the filters
-    pedal1_filter.addSample(pedal_1);
-    pedal2_filter.addSample(pedal_2);
-    brake_filter.addSample(brake);
+    // Add new samples to the filters, all channels in one pass
+    const uint16_t samples[PEDAL_INPUT_COUNT] = {pedal_1, pedal_2, brake};
+    input_filters.addSamples(samples);
+    pedal_1 = input_filters.getMedian(static_cast<uint8_t>(PedalInput::Apps5v));
+    pedal_2 = input_filters.getMedian(static_cast<uint8_t>(PedalInput::Apps3v3));
+    brake = input_filters.getMedian(static_cast<uint8_t>(PedalInput::Brake));
 
     if (pedal_1 < APPS_5V_MIN)
         car.pedal.faults.bits.apps_5v_low = true;
@@ -152,30 +189,40 @@ void Pedal::update(uint16_t pedal_1, uint16_t pedal_2, uint16_t brake)
 
 /**
  * @brief Sends the appropriate CAN frame to the motor based on pedal and car state.
+ * The frame is queued as urgent, replacing a torque command still waiting for TXB2.
  */
 void Pedal::sendFrame()
 {
-    // Update Telemetry struct
-    car.pedal.apps_5v = pedal1_filter.getFiltered();
-    car.pedal.apps_3v3 = pedal2_filter.getFiltered();
-    car.pedal.brake = brake_filter.getFiltered();
+    // Update Telemetry struct from one snapshot of the filters
+    uint16_t filtered[PEDAL_INPUT_COUNT];
+    input_filters.snapshot(filtered);
+    car.pedal.apps_5v = filtered[static_cast<uint8_t>(PedalInput::Apps5v)];
+    car.pedal.apps_3v3 = filtered[static_cast<uint8_t>(PedalInput::Apps3v3)];
+    car.pedal.brake = filtered[static_cast<uint8_t>(PedalInput::Brake)];
+
+    applyPendingMaps();
+
+    // run every tick whatever the state, so the filter is settled when entering Drive
+    if (THROTTLE_BIQUAD_ENABLED)
+        throttle_biquad.addSample(pedal_final);
+    const uint16_t throttle = THROTTLE_BIQUAD_ENABLED ? throttle_biquad.getFiltered() : pedal_final;
 
     if (false && car.pedal.status.bits.force_stop)
     {
-        motor_can.sendMessage(&stop_frame);
+        motor_tx.send(stop_frame, true);
         return;
     }
     if (car.pedal.status.bits.car_status != CarStatus::Drive)
     {
-        motor_can.sendMessage(&stop_frame);
+        motor_tx.send(stop_frame, true);
         return;
     }
 
-    car.motor.torque_val = pedalTorqueMapping(pedal_final, car.pedal.brake, car.motor.motor_rpm, FLIP_MOTOR_DIR);
+    car.motor.torque_val = pedalTorqueMapping(throttle, car.pedal.brake, car.motor.motor_rpm, FLIP_MOTOR_DIR);
 
     torque_msg.data[1] = car.motor.torque_val & 0xFF;
     torque_msg.data[2] = (car.motor.torque_val >> 8) & 0xFF;
-    motor_can.sendMessage(&torque_msg);
+    motor_tx.send(torque_msg, true);
     return;
 }
 
@@ -186,15 +233,22 @@ void Pedal::sendFrame()
  *      applies regen if motor RPM larger than minimum regen RPM,
  *      preventing reverse torque at low speeds.
  *      Regen is also disabled if motor rpm isn't read recently to prevent reverse power.
+ * With RPM_TORQUE_MAP_ENABLED, both are looked up in the active profile over motor RPM as well,
+ *      regen fades in over REGEN_RPM_AXIS instead of switching on at MIN_REGEN_RPM_VAL,
+ *      and throttle uses the 0 RPM row if motor rpm isn't read recently.
+ *      The pedal and brake axes are then located through THROTTLE_MAP_MODE and BRAKE_MAP_MODE.
  *
- * @param pedal Pedal ADC in the range of 0-1023.
- * @param brake Brake ADC in the range of 0-1023.
+ * @param pedal Pedal ADC in the range of 0-ADC_MAX.
+ * @param brake Brake ADC in the range of 0-ADC_MAX.
  * @param motor_rpm Current motor RPM for regen logic, scaled to 0-32767.
  * @param flip_dir Boolean indicating whether to flip the motor direction.
  * @return Mapped torque value in the signed range of -TORQUE_MAX to TORQUE_MAX.
  */
 constexpr int16_t Pedal::pedalTorqueMapping(const uint16_t pedal, const uint16_t brake, const int16_t motor_rpm, const bool flip_dir)
 {
+    // RPM in the driving direction, saturated so flipping -32768 can't overflow
+    const int16_t forward_rpm = !flip_dir ? motor_rpm : (motor_rpm < -PedalConstants::MAX_TORQUE_VAL ? PedalConstants::MAX_TORQUE_VAL : static_cast<int16_t>(-motor_rpm));
+
     if (REGEN_ENABLED && brake > BRAKE_MAP.start() && !car.pedal.status.bits.motor_no_read)
     {
         if (pedal > THROTTLE_MAP.start())
@@ -202,34 +256,208 @@ constexpr int16_t Pedal::pedalTorqueMapping(const uint16_t pedal, const uint16_t
             car.pedal.status.bits.screenshot = true;
             // to ensure BSPD can be tested, skip regen if both throttle and brake pressed
         }
+        else if (RPM_TORQUE_MAP_ENABLED)
+        {
+            // grid is 0 at and below REGEN_RPM_AXIS[0], including when spinning backwards
+            const int16_t regen = REGEN_RPM_MAP.interpAt(regenPosition(brake), forward_rpm, active_maps->profile.regen);
+            return flip_dir ? -regen : regen;
+        }
         else if (!flip_dir)
         {
             if (motor_rpm < PedalConstants::MIN_REGEN_RPM_VAL)
                 return 0;
             else
 
-                return BRAKE_MAP.interp(brake);
+                return brakeTorque(brake);
         }
         else
         {
             if (motor_rpm > -PedalConstants::MIN_REGEN_RPM_VAL)
                 return 0;
             else
-                return -BRAKE_MAP.interp(brake);
+                return -brakeTorque(brake);
         }
     }
 
+    if (RPM_TORQUE_MAP_ENABLED)
+    {
+        const int16_t torque = THROTTLE_RPM_MAP.interpAt(throttlePosition(pedal), car.pedal.status.bits.motor_no_read ? 0 : forward_rpm, active_maps->profile.throttle);
+        return flip_dir ? -torque : torque;
+    }
+
     if (flip_dir)
-        return -THROTTLE_MAP.interp(pedal);
+        return -throttleTorque(pedal);
     else
+        return throttleTorque(pedal);
+}
+
+/**
+ * @brief Returns the buffer not in use, for loading the next maps into.
+ * Any pending swap is cancelled, so a half-written shadow copy is never swapped in.
+ * @return Reference to the shadow copy.
+ */
+PedalMaps &Pedal::shadowMaps()
+{
+    maps_pending = false;
+    return (active_maps == &map_buffers[0]) ? map_buffers[1] : map_buffers[0];
+}
+
+/**
+ * @brief Loads a torque profile from flash into the shadow copy, to be swapped in by sendFrame.
+ * The APPS_3V3 scale in use is kept. The active maps are never written, so a frame is always mapped with one complete set.
+ * Selecting again before the swap replaces the pending profile.
+ * Call from the main loop or a scheduler task, not from an interrupt.
+ *
+ * @param profile Profile to switch to, Calibrated is rejected as it isn't in flash.
+ * @return true if the profile exists and is now pending, false if the id is out of range.
+ * @see applyPendingMaps
+ */
+bool Pedal::selectProfile(const TorqueProfileId profile)
+{
+    if (static_cast<uint8_t>(profile) >= TORQUE_PROFILE_COUNT)
+        return false;
+    PedalMaps &shadow = shadowMaps();
+    shadow = *active_maps;
+    memcpy_P(&shadow.profile, &PROFILES[static_cast<uint8_t>(profile)], sizeof(TorqueProfile));
+    pendShadowMaps(profile);
+    return true;
+}
+
+/**
+ * @brief Validates maps from calibration or EEPROM and loads them into the shadow copy, to be swapped in by sendFrame.
+ * Same rules as selectProfile; the torque profile is reported as TorqueProfileId::Calibrated once swapped in.
+ *
+ * @param maps Maps to switch to.
+ * @return true if the maps passed validProfile and validApps3v3Scale and are now pending, false if rejected.
+ */
+bool Pedal::loadMaps(const PedalMaps &maps)
+{
+    if (!validProfile(maps.profile) || (maps.apps_3v3_scale_calibrated && !validApps3v3Scale(maps.apps_3v3_scale)))
+        return false;
+    shadowMaps() = maps;
+    pendShadowMaps(TorqueProfileId::Calibrated);
+    return true;
+}
+
+/**
+ * @brief Marks the shadow copy as ready to be swapped in, after building the interpolation of its APPS_3V3 scale.
+ * Done here so apps3v3Scaled doesn't check the table for uniform spacing every tick.
+ * @param profile Profile reported once the shadow copy is swapped in.
+ */
+void Pedal::pendShadowMaps(const TorqueProfileId profile)
+{
+    const uint8_t shadow = (active_maps == &map_buffers[0]) ? 1 : 0;
+    apps_3v3_scale_interps[shadow] = Apps3v3ScaleInterp{map_buffers[shadow].apps_3v3_scale};
+    pending_profile = profile;
+    maps_pending = true;
+}
+
+/**
+ * @brief Swaps the pending maps in, called once per tick by sendFrame before any torque is mapped.
+ * Waits until both throttle and brake are released, so switching never steps the torque mid-corner.
+ */
+void Pedal::applyPendingMaps()
+{
+    if (!maps_pending || pedal_final > THROTTLE_MAP.start() || car.pedal.brake > BRAKE_MAP.start())
+        return;
+    active_maps = (active_maps == &map_buffers[0]) ? &map_buffers[1] : &map_buffers[0];
+    maps_pending = false;
+    car.pedal.torque_profile = pending_profile;
+}
+
+/**
+ * @brief Maps the pedal ADC to throttle torque, through the map implementation selected by THROTTLE_MAP_MODE.
+ * @param pedal Pedal ADC in the range of 0-ADC_MAX.
+ * @return Throttle torque, identical for all modes.
+ * @see THROTTLE_MAP_MODE
+ */
+inline int16_t Pedal::throttleTorque(const uint16_t pedal)
+{
+    switch (THROTTLE_MAP_MODE)
+    {
+    case MapMode::FlashLut:
+        return THROTTLE_LUT.lookup(pedal);
+    case MapMode::FixedSlope:
+        return THROTTLE_FIXED_MAP.interp(pedal);
+    default:
         return THROTTLE_MAP.interp(pedal);
+    }
+}
+
+/**
+ * @brief Maps the brake ADC to regen torque, through the map implementation selected by BRAKE_MAP_MODE.
+ * @param brake Brake ADC in the range of 0-ADC_MAX.
+ * @return Regen torque, identical for all modes.
+ * @see BRAKE_MAP_MODE
+ */
+inline int16_t Pedal::brakeTorque(const uint16_t brake)
+{
+    switch (BRAKE_MAP_MODE)
+    {
+    case MapMode::FlashLut:
+        return BRAKE_LUT.lookup(brake);
+    case MapMode::FixedSlope:
+        return BRAKE_FIXED_MAP.interp(brake);
+    default:
+        return BRAKE_MAP.interp(brake);
+    }
+}
+
+/**
+ * @brief Locates the pedal ADC on the APPS axis of THROTTLE_RPM_MAP, from flash with THROTTLE_MAP_MODE FlashLut.
+ * The other modes use the division-free lookup of BilinearInterp, there is no divide to drop.
+ * @param pedal Pedal ADC in the range of 0-ADC_MAX.
+ * @return Position for THROTTLE_RPM_MAP.interpAt, identical for all modes apart from the bits FlashLut drops.
+ * @see THROTTLE_MAP_MODE
+ */
+inline AxisPosition Pedal::throttlePosition(const uint16_t pedal)
+{
+    if (THROTTLE_MAP_MODE == MapMode::FlashLut)
+        return THROTTLE_AXIS_LUT.lookup(pedal);
+    return THROTTLE_RPM_MAP.locateX(pedal);
+}
+
+/**
+ * @brief Locates the brake ADC on the brake axis of REGEN_RPM_MAP, from flash with BRAKE_MAP_MODE FlashLut.
+ * The other modes use the division-free lookup of BilinearInterp, there is no divide to drop.
+ * @param brake Brake ADC in the range of 0-ADC_MAX.
+ * @return Position for REGEN_RPM_MAP.interpAt, identical for all modes apart from the bits FlashLut drops.
+ * @see BRAKE_MAP_MODE
+ */
+inline AxisPosition Pedal::regenPosition(const uint16_t brake)
+{
+    if (BRAKE_MAP_MODE == MapMode::FlashLut)
+        return REGEN_AXIS_LUT.lookup(brake);
+    return REGEN_RPM_MAP.locateX(brake);
+}
+
+/**
+ * @brief Scales the APPS_3V3 ADC to the APPS_5V range, through the map implementation selected by APPS_3V3_SCALE_MAP_MODE.
+ * A calibrated table is in RAM and can't use the compile-time maps, so it uses the LinearInterp built when it was loaded.
+ * @param apps_3v3 APPS_3V3 ADC in the range of 0-ADC_MAX.
+ * @return Equivalent APPS_5V ADC, identical for all modes.
+ * @see APPS_3V3_SCALE_MAP_MODE
+ */
+inline uint16_t Pedal::apps3v3Scaled(const uint16_t apps_3v3) const
+{
+    if (active_maps->apps_3v3_scale_calibrated)
+        return apps_3v3_scale_interps[(active_maps == &map_buffers[0]) ? 0 : 1].interp(apps_3v3);
+    switch (APPS_3V3_SCALE_MAP_MODE)
+    {
+    case MapMode::FlashLut:
+        return APPS_3V3_SCALE_LUT.lookup(apps_3v3);
+    case MapMode::FixedSlope:
+        return APPS_3V3_SCALE_FIXED_MAP.interp(apps_3v3);
+    default:
+        return APPS_3V3_SCALE_MAP.interp(apps_3v3);
+    }
 }
 
 /**
  * @brief Checks for a fault between two pedal sensor readings.
  *
  * Scales pedal_2 to match the range of pedal_1, then calculates the absolute difference.
- * If the difference exceeds 10% of the full-scale value (i.e., >102.4 for a 10-bit ADC),
+ * If the difference exceeds 10% of the APPS_5V travel (THROTTLE_MAP range, in ADC_BITS),
  * the function considers this a fault and returns true. Otherwise, returns false.
  *
  * @return true if the difference exceeds the threshold (fault detected), false otherwise.
@@ -240,7 +468,7 @@ bool Pedal::checkPedalFault()
     {
         return false;
     }
-    const int16_t delta = (int16_t)car.pedal.apps_5v - (int16_t)APPS_3V3_SCALE_MAP.interp(car.pedal.apps_3v3);
+    const int16_t delta = (int16_t)car.pedal.apps_5v - (int16_t)apps3v3Scaled(car.pedal.apps_3v3);
     constexpr int16_t MAX_DELTA = THROTTLE_MAP.range() / 10; /**< MAX_DELTA is floor of 10% of APPS_5V valid range, later comparison will give rounding room */
     // if more than 10% difference between the two pedals, consider it a fault
     if (delta > MAX_DELTA || delta < -MAX_DELTA)
@@ -264,13 +492,19 @@ MCP2515::ERROR Pedal::sendCyclicRead(const uint8_t reg_id, const uint8_t read_pe
         reg_id,     /**< data, sub ID */
         read_period /**< data, read period in ms */
     };
-    return motor_can.sendMessage(&cyclic_request);
+    return motor_tx.sendDirect(cyclic_request); // shares MOTOR_SEND with the torque command, can't be queued
 }
 
+/**
+ * @brief Checks for the reply to a cyclic read request.
+ * Reads RXB0 only, RXB1 holds the command frames when the MCP2515 is shared with Command.
+ * @param reg_id Register ID the reply must be for.
+ * @return true if the reply was read, false otherwise.
+ */
 bool Pedal::checkCyclicRead(const uint8_t reg_id)
 {
     can_frame rx_frame;
-    if (motor_can.readMessage(&rx_frame) == MCP2515::ERROR_OK &&
+    if (motor_can.readMessage(MCP2515::RXB0, &rx_frame) == MCP2515::ERROR_OK &&
         rx_frame.can_id == MOTOR_READ &&
         rx_frame.can_dlc > 3 &&
         rx_frame.data[0] == reg_id)
@@ -281,33 +515,44 @@ bool Pedal::checkCyclicRead(const uint8_t reg_id)
 }
 
 /**
- * @brief Reads motor data from the CAN bus and updates the CarState.
+ * @brief Reads all motor data received on the CAN bus and updates the CarState.
+ * Empties the receive buffers, so SPEED_IST and WARN_ERR arriving together don't overflow them, counting overflows into car.can.
+ * Flags motor_no_read if nothing was read for MAX_MOTOR_READ_MILLIS, also when not reading.
+ * @param rx_pending false if the MCP2515 has nothing received (e.g. its INT line is high), skips the SPI read.
+ * @param rx_buffers Receive buffers of the motor bus, see canDrainRx, only RXB0 if the MCP2515 is shared with Command.
+ * @return true if a frame was read, false if there was none.
  */
-void Pedal::readMotor()
+bool Pedal::readMotor(const bool rx_pending, const uint8_t rx_buffers)
 {
-    can_frame rx_frame;
-    if (motor_can.readMessage(&rx_frame) == MCP2515::ERROR_OK)
-    {
-        if (rx_frame.can_id == MOTOR_READ && rx_frame.can_dlc > 3)
-        {
-            if (rx_frame.data[0] == SPEED_IST)
-            {
-                last_motor_read_millis = car.millis;
-                car.pedal.status.bits.motor_no_read = false;
-                car.motor.motor_rpm = static_cast<int16_t>(rx_frame.data[1] | (rx_frame.data[2] << 8));
-                return;
-            }
-            else if (rx_frame.data[0] == WARN_ERR)
-            {
-                car.motor.motor_error = static_cast<uint16_t>(rx_frame.data[1] | (rx_frame.data[2] << 8));
-                car.motor.motor_warn = static_cast<uint16_t>(rx_frame.data[3] | (rx_frame.data[4] << 8));
-                return;
-            }
-        }
-    }
+    uint8_t frames = 0;
+    if (rx_pending)
+        frames = canDrainRx(motor_can, rx_buffers, car.can.rx_overruns[static_cast<uint8_t>(McpIndex::Motor)],
+                            [this](const can_frame &rx_frame) { readMotorFrame(rx_frame); });
     if (car.millis - last_motor_read_millis > MAX_MOTOR_READ_MILLIS)
     {
         car.pedal.status.bits.motor_no_read = true;
     }
-    return;
+    return frames != 0;
+}
+
+/**
+ * @brief Updates the CarState from a frame received on the motor bus.
+ * Called by readMotor, and for frames rolled over into RXB1 when the MCP2515 is shared with Command.
+ * @param rx_frame Received frame, ignored unless it is a SPEED_IST or WARN_ERR reply.
+ */
+void Pedal::readMotorFrame(const can_frame &rx_frame)
+{
+    if (rx_frame.can_id != MOTOR_READ || rx_frame.can_dlc <= 3)
+        return;
+    if (rx_frame.data[0] == SPEED_IST)
+    {
+        last_motor_read_millis = car.millis;
+        car.pedal.status.bits.motor_no_read = false;
+        car.motor.motor_rpm = static_cast<int16_t>(rx_frame.data[1] | (rx_frame.data[2] << 8));
+    }
+    else if (rx_frame.data[0] == WARN_ERR)
+    {
+        car.motor.motor_error = static_cast<uint16_t>(rx_frame.data[1] | (rx_frame.data[2] << 8));
+        car.motor.motor_warn = static_cast<uint16_t>(rx_frame.data[3] | (rx_frame.data[4] << 8));
+    }
 }
\ No newline at end of file
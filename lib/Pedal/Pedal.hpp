@@ -2,8 +2,8 @@
  * @file Pedal.hpp
  * @author Planeson, Red Bird Racing
  * @brief Declaration of the Pedal class for handling throttle and brake pedal inputs
- * @version 1.6
- * @date 2026-02-12
+ * @version 1.25
+ * @date 2026-10-16
  * @see Pedal.cpp
  * @dir Pedal @brief The Pedal library contains the Pedal class to manage throttle and brake pedal inputs, including filtering, fault detection, and CAN communication.
  */
@@ -13,9 +13,13 @@
 
 #include <stdint.h>
 #include "CarState.hpp"
+#include "Enums.hpp"
 #include "Interp.hpp"
 #include "Curves.hpp"
 #include "SignalProcessing.hpp"
+#include "Scheduler.hpp"
+#include "CanRx.hpp"
+#include "CanTx.hpp"
 
 // ignore -Wpedantic warnings for mcp2515.h
 #pragma GCC diagnostic push
@@ -33,6 +37,22 @@ constexpr bool BRAKE_RELIABLE = true; /**< brake assumed reliable; enable checki
 
 constexpr uint16_t FAULT_CHECK_HEX = BRAKE_RELIABLE ? 0xFE : 0x3E; /**< Hex mask for fault checking based on brake reliability. */
 
+constexpr uint8_t SPIKE_MEDIAN_TAPS = 3; /**< Taps of the median in front of the filters and range checks; 3 rejects single-sample spikes, 5 rejects two in a row. */
+
+constexpr uint8_t PEDAL_FILTER_SHIFT = 3; /**< Exponential average of the APPS and brake inputs, each new sample weighs 1/2^3; each sample already averages 4^ADC_OVERSAMPLE_BITS conversions. */
+
+constexpr bool THROTTLE_BIQUAD_ENABLED = false;  /**< Boolean toggle for the throttle low-pass at the scheduler rate before the torque map; lower PEDAL_FILTER_SHIFT when enabling, the lags add up. */
+constexpr double THROTTLE_BIQUAD_CUTOFF_HZ = 8;  /**< Cutoff of the throttle low-pass, below half the scheduler rate. */
+constexpr double THROTTLE_BIQUAD_Q = 0.7071;     /**< Quality factor of the throttle low-pass, 0.7071 is Butterworth (no peak). */
+static_assert(THROTTLE_BIQUAD_CUTOFF_HZ * 2 * SCHEDULER_PERIOD_US < 1000000, "THROTTLE_BIQUAD_CUTOFF_HZ must be below half the scheduler rate");
+constexpr BiquadCoefficients<int16_t> THROTTLE_BIQUAD = biquadLowPass<int16_t>(THROTTLE_BIQUAD_CUTOFF_HZ, THROTTLE_BIQUAD_Q, SCHEDULER_PERIOD_US); /**< Throttle low-pass coefficients, Q2.14 */
+
+constexpr MapMode THROTTLE_MAP_MODE = MapMode::FixedSlope;     /**< Implementation of the throttle torque map, see MapMode for the memory cost; FlashLut drops the ADC_OVERSAMPLE_BITS. With RPM_TORQUE_MAP_ENABLED, selects the APPS axis lookup of the grid instead. */
+constexpr MapMode BRAKE_MAP_MODE = MapMode::FixedSlope;        /**< Implementation of the regen torque map, see MapMode for the memory cost; FlashLut drops the ADC_OVERSAMPLE_BITS. With RPM_TORQUE_MAP_ENABLED, selects the brake axis lookup of the grid instead. */
+constexpr MapMode APPS_3V3_SCALE_MAP_MODE = MapMode::FlashLut; /**< Implementation of the APPS_3V3->APPS_5V map, see MapMode for the memory cost. */
+
+constexpr bool RPM_TORQUE_MAP_ENABLED = false; /**< Boolean toggle for the APPS x RPM and brake x RPM grids of the torque profiles; false uses the 1D curves with a hard regen cutoff at MIN_REGEN_RPM_VAL, ignoring the profile. Off until test_bench_rpm_maps has been run on target and fits the tick. */
+
 constexpr uint32_t MAX_MOTOR_READ_MILLIS = 100; /**< Maximum time in milliseconds between motor data reads before disabling regen. */
 
 /**
@@ -58,7 +78,21 @@ namespace PedalConstants
     constexpr int16_t MIN_REGEN_RPM_VAL =
         (double)MIN_REGEN_KMH / MINUTES_PER_HOUR * INCH_PER_KM / WHEEL_DIAMETER_INCH / PI_ * GEAR_RATIO_NUMERATOR / GEAR_RATIO_DENOMINATOR * MAX_TORQUE_VAL / MAX_MOTOR_RPM; /**< Minimum RPM for regenerative braking to be active. */
 } // namespace PedalConstants
+static_assert(REGEN_RPM_AXIS[0] >= PedalConstants::MIN_REGEN_RPM_VAL, "TorqueProfile::regen must not regen below MIN_REGEN_KMH");
 constexpr uint8_t ADC_BUFFER_SIZE = 16; /**< Size of the ADC reading buffer for filtering. */
+constexpr uint16_t ADC_LUT_SIZE = 1024; /**< Number of entries in the dense flash tables, one per 10-bit ADC value, indexed with ADC_OVERSAMPLE_BITS dropped. */
+
+/**
+ * @brief Tables Pedal maps with at runtime, double-buffered so a new set can be loaded while the old one is in use.
+ * Also the layout of the calibration edit buffer and the EEPROM copy.
+ */
+struct PedalMaps
+{
+    TorqueProfile profile;                                                /**< Throttle and regen grids */
+    TablePoint<uint16_t, uint16_t> apps_3v3_scale[APPS_3V3_SCALE_POINTS]; /**< APPS_3V3->APPS_5V table, used if apps_3v3_scale_calibrated */
+    bool apps_3v3_scale_calibrated;                                       /**< false uses APPS_3V3_SCALE_TABLE through APPS_3V3_SCALE_MAP_MODE */
+};
+using Apps3v3ScaleInterp = LinearInterp<uint16_t, uint16_t, uint32_t, APPS_3V3_SCALE_POINTS>; /**< Interpolation of PedalMaps::apps_3v3_scale */
 
 /**
  * @brief Pedal class for managing throttle and brake pedal inputs.
@@ -67,23 +101,44 @@ constexpr uint8_t ADC_BUFFER_SIZE = 16; /**< Size of the ADC reading buffer for
 class Pedal
 {
 public:
-    Pedal(MCP2515 &motor_can_, CarState &car, uint16_t &pedal_final_);
+    Pedal(MCP2515 &motor_can_, CanTxQueue &motor_tx_, CarState &car, uint16_t &pedal_final_);
     void update(uint16_t pedal_1, uint16_t pedal_2, uint16_t brake);
     void sendFrame();
     void initFilter();
     bool initMotor();
-    void readMotor();
+    bool readMotor(bool rx_pending = true, uint8_t rx_buffers = CAN_RX_ALL_BUFFERS);
+    void readMotorFrame(const can_frame &rx_frame);
+    bool selectProfile(TorqueProfileId profile);
+    bool loadMaps(const PedalMaps &maps);
+    /**
+     * @brief Returns the tables in use, e.g. as the starting point of a calibration
+     * @return Reference to the active maps, valid until the next swap
+     */
+    const PedalMaps &getMaps() const { return *active_maps; }
+    /**
+     * @brief Returns the profile that will be in use once the pending maps are swapped in, e.g. to cycle from
+     * @return Pending profile if a swap is pending, else the profile in use
+     */
+    TorqueProfileId getPendingProfile() const { return maps_pending ? pending_profile : car.pedal.torque_profile; }
     uint16_t &pedal_final; /**< Final pedal value is taken directly from apps_5v, see initializer */
 
 private:
     CarState &car;                   /**< Reference to CarState */
     MCP2515 &motor_can;              /**< Reference to MCP2515 for sending CAN messages */
+    CanTxQueue &motor_tx;            /**< Reference to the TX queue of motor_can, for all frames sent */
     uint32_t fault_start_millis;     /**< Timestamp for when a fault started */
     uint32_t last_motor_read_millis; /**< Timestamp for the last motor data read */
 
     bool got_speed; /**< Flag indicating if motor speed data has been successfully read */
     bool got_error; /**< Flag indicating if motor error data has been successfully read */
 
+    static const TorqueProfile PROFILES[TORQUE_PROFILE_COUNT]; /**< All torque profiles in flash, indexed by TorqueProfileId */
+    PedalMaps map_buffers[2];                                 /**< Active maps and the shadow copy the next ones are loaded into */
+    const PedalMaps *active_maps;                             /**< Maps used by pedalTorqueMapping and checkPedalFault, points into map_buffers */
+    TorqueProfileId pending_profile;                          /**< Profile loaded into the shadow copy, valid while maps_pending */
+    bool maps_pending;                                        /**< Flag indicating the shadow copy is ready to be swapped in */
+    Apps3v3ScaleInterp apps_3v3_scale_interps[2];             /**< Interpolation of apps_3v3_scale of each map_buffers entry, rebuilt when loaded */
+
     /**
      * @brief CAN frame to stop the motor
      */
@@ -104,14 +159,32 @@ private:
         0x00,       /**< data, init as 0 torque * 2 */
         0x00};
 
-    // Filters for pedal and brake inputs, see Signal_Processing.hpp for options
-    ExponentialFilter<uint16_t, uint16_t> pedal1_filter; /**< Filter for first pedal sensor input */
-    ExponentialFilter<uint16_t, uint16_t> pedal2_filter; /**< Filter for second pedal sensor input */
-    ExponentialFilter<uint16_t, uint16_t> brake_filter;  /**< Filter for brake sensor input */
+    // Filters for all analog inputs, channels in PedalInput order, see SignalProcessing.hpp for options
+    // the median stage removes EMI spikes, range checks read it through getMedian()
+    FilterBank<SPIKE_MEDIAN_TAPS, PEDAL_FILTER_SHIFT, PEDAL_FILTER_SHIFT, PEDAL_FILTER_SHIFT> input_filters; /**< Median then exponential average of every PedalInput */
+    static_assert(decltype(input_filters)::CHANNELS == PEDAL_INPUT_COUNT, "input_filters must have one channel per PedalInput");
+    BiquadFilter<uint16_t> throttle_biquad{THROTTLE_BIQUAD}; /**< Throttle low-pass, run by sendFrame every tick if THROTTLE_BIQUAD_ENABLED */
+
+    static constexpr LinearInterp<uint16_t, int16_t, int32_t, 5> THROTTLE_MAP{THROTTLE_TABLE};                                   /**< Interpolation map for throttle torque */
+    static constexpr LinearInterp<uint16_t, int16_t, int32_t, 5> BRAKE_MAP{BRAKE_TABLE};                                         /**< Interpolation map for brake torque */
+    static constexpr LinearInterp<uint16_t, uint16_t, uint32_t, APPS_3V3_SCALE_POINTS> APPS_3V3_SCALE_MAP{APPS_3V3_SCALE_TABLE}; /**< Interpolation map for APPS_3V3->APPS_5V */
+
+    static constexpr BilinearInterp<uint16_t, int16_t, int16_t, int32_t, TORQUE_GRID_PEDAL_POINTS, TORQUE_GRID_RPM_POINTS> THROTTLE_RPM_MAP{THROTTLE_APPS_AXIS, THROTTLE_RPM_AXIS}; /**< Interpolation map for throttle torque over APPS and motor RPM, grid from the active profile */
+    static constexpr BilinearInterp<uint16_t, int16_t, int16_t, int32_t, TORQUE_GRID_PEDAL_POINTS, TORQUE_GRID_RPM_POINTS> REGEN_RPM_MAP{REGEN_BRAKE_AXIS, REGEN_RPM_AXIS};         /**< Interpolation map for regen torque over brake and motor RPM, grid from the active profile */
+
+    static constexpr FixedSlopeInterp<uint16_t, int16_t, int32_t, 5> THROTTLE_FIXED_MAP{THROTTLE_TABLE};                                   /**< Division-free THROTTLE_MAP, see THROTTLE_MAP_MODE */
+    static constexpr FixedSlopeInterp<uint16_t, int16_t, int32_t, 5> BRAKE_FIXED_MAP{BRAKE_TABLE};                                         /**< Division-free BRAKE_MAP, see BRAKE_MAP_MODE */
+    static constexpr FixedSlopeInterp<uint16_t, uint16_t, uint32_t, APPS_3V3_SCALE_POINTS> APPS_3V3_SCALE_FIXED_MAP{APPS_3V3_SCALE_TABLE}; /**< Division-free APPS_3V3_SCALE_MAP, see APPS_3V3_SCALE_MAP_MODE */
+
+    static_assert(THROTTLE_FIXED_MAP.maxError() == 0, "THROTTLE_FIXED_MAP must match THROTTLE_MAP exactly");
+    static_assert(BRAKE_FIXED_MAP.maxError() == 0, "BRAKE_FIXED_MAP must match BRAKE_MAP exactly");
+    static_assert(APPS_3V3_SCALE_FIXED_MAP.maxError() == 0, "APPS_3V3_SCALE_FIXED_MAP must match APPS_3V3_SCALE_MAP exactly");
 
-    static constexpr LinearInterp<uint16_t, int16_t, int32_t, 5> THROTTLE_MAP{THROTTLE_TABLE};               /**< Interpolation map for throttle torque */
-    static constexpr LinearInterp<uint16_t, int16_t, int32_t, 5> BRAKE_MAP{BRAKE_TABLE};                     /**< Interpolation map for brake torque */
-    static constexpr LinearInterp<uint16_t, uint16_t, uint32_t, 3> APPS_3V3_SCALE_MAP{APPS_3V3_SCALE_TABLE}; /**< Interpolation map for APPS_3V3->APPS_5V */
+    static const FlashLut<int16_t, ADC_LUT_SIZE, ADC_OVERSAMPLE_BITS> THROTTLE_LUT;        /**< THROTTLE_MAP expanded into flash, see THROTTLE_MAP_MODE */
+    static const FlashLut<int16_t, ADC_LUT_SIZE, ADC_OVERSAMPLE_BITS> BRAKE_LUT;           /**< BRAKE_MAP expanded into flash, see BRAKE_MAP_MODE */
+    static const FlashLut<uint16_t, ADC_LUT_SIZE, ADC_OVERSAMPLE_BITS> APPS_3V3_SCALE_LUT; /**< APPS_3V3_SCALE_MAP expanded into flash, see APPS_3V3_SCALE_MAP_MODE */
+    static const FlashAxisLut<ADC_LUT_SIZE, ADC_OVERSAMPLE_BITS> THROTTLE_AXIS_LUT;        /**< APPS axis of THROTTLE_RPM_MAP expanded into flash, see THROTTLE_MAP_MODE */
+    static const FlashAxisLut<ADC_LUT_SIZE, ADC_OVERSAMPLE_BITS> REGEN_AXIS_LUT;           /**< Brake axis of REGEN_RPM_MAP expanded into flash, see BRAKE_MAP_MODE */
 
     static constexpr canid_t MOTOR_SEND = 0x201; /**< Motor send CAN ID */
     static constexpr canid_t MOTOR_READ = 0x181; /**< Motor read CAN ID */
@@ -125,6 +198,14 @@ private:
     static constexpr uint8_t ERR_PERIOD = 20; /**< Period of reading motor errors in ms, set to 20ms to get 10ms reads alongside rpm */
 
     bool checkPedalFault();
+    void applyPendingMaps();
+    PedalMaps &shadowMaps();
+    void pendShadowMaps(TorqueProfileId profile);
+    static int16_t throttleTorque(const uint16_t pedal);
+    static int16_t brakeTorque(const uint16_t brake);
+    static AxisPosition throttlePosition(const uint16_t pedal);
+    static AxisPosition regenPosition(const uint16_t brake);
+    uint16_t apps3v3Scaled(const uint16_t apps_3v3) const;
     constexpr int16_t pedalTorqueMapping(const uint16_t pedal, const uint16_t brake, const int16_t motor_rpm, const bool flip_dir);
 
     MCP2515::ERROR sendCyclicRead(uint8_t reg_id, uint8_t read_period);
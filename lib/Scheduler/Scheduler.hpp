@@ -2,9 +2,9 @@
  * @file Scheduler.hpp
  * @author Planeson, Red Bird Racing
  * @brief Declaration of the Scheduler class template, for scheduling tasks on multiple MCP2515 instances
- * @version 1.2
- * @date 2026-02-28
- * @see Scheduler.tpp
+ * @version 1.7
+ * @date 2026-10-16
+ * @see Scheduler.tpp, StaticScheduler.hpp
  * @dir Scheduler @brief The Scheduler library contains the Scheduler class template, which manages the scheduling of tasks for multiple MCP2515 instances, allowing for periodic execution of functions based on a specified time interval and spin-wait threshold.
  */
 
@@ -12,6 +12,11 @@
 #define SCHEDULER_HPP
 
 #include "Enums.hpp"
+#include "SchedulerClock.hpp"
+#include "TaskPhase.hpp"
+
+constexpr uint32_t SCHEDULER_PERIOD_US = 10000; /**< Tick period of the VCU scheduler, also the sample period of filters run from its tasks */
+constexpr uint32_t SCHEDULER_BUDGET_US = 8000;  /**< Time after a tick is due by which its non-critical tasks must have started, see StaticScheduler */
 
 /**
  * @brief Scheduler class template for scheduling tasks on multiple MCP2515 instances
@@ -24,10 +29,9 @@
  * it holds function pointers to tasks that handle sending and receiving messages for each MCP2515.
  * The object wishing to send/receive messages holds their own MCP2515 object (reference).
  *
- * The Scheduler runs on a fixed period. When Scheduler.update() is called, it checks if a period has already passed.
- * If not, it checks if it is almost passed. If the time to the next cycle is less than SPIN_US, it spin-waits until the period is reached.
- * Otherwise, it returns immediately, allowing other non-scheduler tasks to run.
+ * The Scheduler runs on a fixed period, see SchedulerClock for when a tick fires and the spin-wait before it.
  * Once the time to fire is reached, it runs the tasks via the pointers in a round-robin fashion, going from one MCP2515 to another.
+ * Tasks can be added and removed at runtime; for a schedule known at compile time, StaticScheduler dispatches with less overhead.
  *
  * With a modified mcp2515.h that doesn't directly use SPI.h, we can skip waiting for the SPI transaction to complete,
  * and instead work on compiling the next message while the previous SPI transaction is still ongoing.
@@ -35,8 +39,6 @@
  * we give room for the CAN-bus to be busy on one MCP2515, while another MCP2515 can still send/receive messages,
  * i.e. we distribute the load across multiple CAN buses more evenly, instead of having one bus burst at one time
  *
- * In the rare case where the system is busy and misses more than one period, the scheduler will skip to the next period, preventing bursts.
- *
  * @tparam NUM_TASKS Number of tasks per MCP2515, choose highest of all, but keep as low as possible
  * @tparam NUM_MCP2515 Number of MCP2515 instances
  */
@@ -52,32 +54,30 @@ public:
 
     void update();
     void synchronize(unsigned long (*const current_time_us)());
-    bool addTask(const McpIndex mcp_index, const TaskFn task, const uint8_t tick_interval);
+    bool addTask(const McpIndex mcp_index, const TaskFn task, const uint8_t tick_interval, const uint16_t phase = 0);
     bool removeTask(const McpIndex mcp_index, const TaskFn task);
 
     /**
      * @brief Returns the period of the scheduler in microseconds.
      * @return The period in microseconds.
      */
-    constexpr uint32_t getPeriodUs() const { return PERIOD_US; }
+    constexpr uint32_t getPeriodUs() const { return clock.getPeriodUs(); }
 
     /**
      * @brief Returns the number of cycles needed for a given interval in microseconds.
      * @param[in] interval_us The interval in microseconds.
      * @return The number of cycles needed.
      */
-    constexpr uint32_t cyclesNeeded(const uint32_t interval_us) const { return interval_us / PERIOD_US; }
+    constexpr uint32_t cyclesNeeded(const uint32_t interval_us) const { return interval_us / clock.getPeriodUs(); }
 
 private:
     TaskFn tasks[NUM_MCP2515][NUM_TASKS];          /**< Array of tasks, sorted by each MCP2515. */
     uint8_t task_ticks[NUM_MCP2515][NUM_TASKS];    /**< Period (in ticks) of each function, 1 is fire every tick, 0 is disabled. */
     uint8_t task_counters[NUM_MCP2515][NUM_TASKS]; /**< Counter to hold firing for n ticks, "how many ticks left before firing?". */
     uint8_t task_cnt[NUM_MCP2515];                 /**< Array of number of tasks per MCP2515. */
-    const uint32_t PERIOD_US;                      /**< Period (tick length). */
-    const uint32_t SPIN_US;                        /**< Threshold to switch from letting non-scheduler task in loop() run, to spin-locking (to ensure on time firing). */
-    uint32_t last_fire_us;                         /**< Last time scheduler fired, overridden if missed more than one period. */
-    unsigned long (*const CURRENT_TIME_US)();      /**< Function pointer to a function returning the current time in microseconds. */
+    SchedulerClock clock;                          /**< Decides when a tick fires */
 
+    uint8_t autoPhase(uint8_t mcp_idx, uint8_t tick_interval) const;
     inline void runTasks();
 };
 
@@ -2,8 +2,8 @@
  * @file Scheduler.tpp
  * @author Planeson, Red Bird Racing
  * @brief Implementation of the Scheduler class template
- * @version 1.2
- * @date 2026-02-28
+ * @version 1.6
+ * @date 2026-10-16
  * @see Scheduler.hpp
  */
 
@@ -26,10 +26,7 @@ Scheduler<NUM_TASKS, NUM_MCP2515>::Scheduler(uint32_t period_us_,
       task_ticks{0},
       task_counters{0}, // run on first tick
       task_cnt{0},
-      PERIOD_US(period_us_),
-      SPIN_US(spin_threshold_us_),
-      last_fire_us(0),
-      CURRENT_TIME_US(current_time_us)
+      clock(period_us_, spin_threshold_us_, current_time_us)
 {
 }
 
@@ -38,34 +35,12 @@ Scheduler<NUM_TASKS, NUM_MCP2515>::Scheduler(uint32_t period_us_,
  *
  * @tparam NUM_TASKS Number of tasks per MCP2515
  * @tparam NUM_MCP2515 Number of MCP2515 instances
- * @param[in] current_time_us Function pointer to a function returning the current time in microseconds
  */
 template <uint8_t NUM_TASKS, uint8_t NUM_MCP2515>
 void Scheduler<NUM_TASKS, NUM_MCP2515>::update()
 {
-    uint32_t delta = CURRENT_TIME_US() - last_fire_us;
-    if (delta >= PERIOD_US)
-    {
-        runTasks();
-        if (delta >= 2 * PERIOD_US)
-            // we missed more than one period, override last_fire_us to avoid bursts
-            last_fire_us = CURRENT_TIME_US();
-        else
-            last_fire_us += PERIOD_US;
-
-        return;
-    }
-    // not time yet, check if we should spin-wait or return
-    if (delta >= PERIOD_US - SPIN_US)
-    {
-        // spin-wait
-        while ((uint32_t)(CURRENT_TIME_US() - last_fire_us) < PERIOD_US)
-            ;
-        // now it's time, run the tasks
+    if (clock.due())
         runTasks();
-        last_fire_us += PERIOD_US;
-    }
-    return;
 }
 
 /**
@@ -81,7 +56,7 @@ void Scheduler<NUM_TASKS, NUM_MCP2515>::synchronize(unsigned long (*const curren
     if (current_time_us == nullptr)
         return;
 
-    last_fire_us = current_time_us();
+    clock.synchronize(current_time_us);
     for (uint8_t mcp_index = 0; mcp_index < NUM_MCP2515; ++mcp_index)
     {
         for (uint8_t task_index = 0; task_index < NUM_TASKS; ++task_index)
@@ -99,10 +74,11 @@ void Scheduler<NUM_TASKS, NUM_MCP2515>::synchronize(unsigned long (*const curren
  * @param[in] mcp_index Index of the MCP2515 instance
  * @param[in] task Function pointer to the task to be added
  * @param[in] tick_interval Number of ticks between task executions, so 1 for every tick, 10 for every 10 ticks; 0 makes the given task disabled from repeating.
- * @return true if the task was added successfully, false otherwise
+ * @param[in] phase Ticks to wait before the first run, below tick_interval, 0 for the next tick, TASK_AUTO_PHASE to pick the one meeting the fewest other multi-tick tasks
+ * @return true if the task was added successfully, false if full or the phase is out of range (e.g. 0xFF, not the TASK_AUTO_PHASE of this API)
  */
 template <uint8_t NUM_TASKS, uint8_t NUM_MCP2515>
-bool Scheduler<NUM_TASKS, NUM_MCP2515>::addTask(const McpIndex mcp_index, const TaskFn task, const uint8_t tick_interval)
+bool Scheduler<NUM_TASKS, NUM_MCP2515>::addTask(const McpIndex mcp_index, const TaskFn task, const uint8_t tick_interval, const uint16_t phase)
 {
     uint8_t mcp_idx = static_cast<uint8_t>(mcp_index);
     if (mcp_idx >= NUM_MCP2515 || task == nullptr)
@@ -110,10 +86,17 @@ bool Scheduler<NUM_TASKS, NUM_MCP2515>::addTask(const McpIndex mcp_index, const
 
     if (task_cnt[mcp_idx] >= NUM_TASKS)
         return false; // full
+    if (phase != TASK_AUTO_PHASE && tick_interval != 0 && phase >= tick_interval)
+        return false; // same rule as StaticTask
 
     tasks[mcp_idx][task_cnt[mcp_idx]] = task;
     task_ticks[mcp_idx][task_cnt[mcp_idx]] = tick_interval;
-    task_counters[mcp_idx][task_cnt[mcp_idx]] = 1; // run on first tick
+    if (tick_interval <= 1)
+        task_counters[mcp_idx][task_cnt[mcp_idx]] = 1; // run on first tick
+    else if (phase == TASK_AUTO_PHASE)
+        task_counters[mcp_idx][task_cnt[mcp_idx]] = autoPhase(mcp_idx, tick_interval) + 1;
+    else
+        task_counters[mcp_idx][task_cnt[mcp_idx]] = phase + 1;
     ++task_cnt[mcp_idx];
     return true;
 }
@@ -158,6 +141,47 @@ bool Scheduler<NUM_TASKS, NUM_MCP2515>::removeTask(const McpIndex mcp_index, con
     return false;
 }
 
+/**
+ * @brief Picks the phase of a new multi-tick task that meets the fewest other multi-tick tasks, on its MCP2515 first, then on any
+ * Phases are counted from the next tick, other tasks are next due when their counter reaches 1.
+ *
+ * @tparam NUM_TASKS Number of tasks per MCP2515
+ * @tparam NUM_MCP2515 Number of MCP2515 instances
+ * @param[in] mcp_idx Index of the MCP2515 instance of the new task
+ * @param[in] tick_interval Ticks between runs of the new task, above 1
+ * @return Ticks to wait before the first run
+ */
+template <uint8_t NUM_TASKS, uint8_t NUM_MCP2515>
+uint8_t Scheduler<NUM_TASKS, NUM_MCP2515>::autoPhase(const uint8_t mcp_idx, const uint8_t tick_interval) const
+{
+    uint8_t best_phase = 0;
+    uint16_t best_cost = UINT16_MAX;
+    for (uint8_t phase = 0; phase < tick_interval; ++phase)
+    {
+        uint8_t same_mcp = 0;
+        uint8_t any_mcp = 0;
+        for (uint8_t mcp = 0; mcp < NUM_MCP2515; ++mcp)
+        {
+            for (uint8_t i = 0; i < task_cnt[mcp]; ++i)
+            {
+                if (task_ticks[mcp][i] <= 1 || task_counters[mcp][i] == 0)
+                    continue; // every tick or not repeating
+                if (!phasesCollide(phase, tick_interval, task_counters[mcp][i] - 1, task_ticks[mcp][i]))
+                    continue;
+                ++any_mcp;
+                if (mcp == mcp_idx)
+                    ++same_mcp;
+            }
+        }
+        if (phaseCost(same_mcp, any_mcp) < best_cost)
+        {
+            best_cost = phaseCost(same_mcp, any_mcp);
+            best_phase = phase;
+        }
+    }
+    return best_phase;
+}
+
 /**
  * @brief Helper function to run scheduled tasks
  *
@@ -0,0 +1,78 @@
+/**
+ * @file SchedulerClock.cpp
+ * @author Planeson, Red Bird Racing
+ * @brief Implementation of the SchedulerClock class
+ * @version 1.1
+ * @date 2026-10-16
+ * @see SchedulerClock.hpp
+ */
+
+#include "SchedulerClock.hpp"
+
+/**
+ * @brief Construct a new SchedulerClock object
+ *
+ * @param[in] period_us_ Period of the ticks in microseconds
+ * @param[in] spin_threshold_us_ Spin-wait threshold in microseconds
+ * @param[in] current_time_us Function pointer to a function returning the current time in microseconds
+ */
+SchedulerClock::SchedulerClock(const uint32_t period_us_,
+                               const uint32_t spin_threshold_us_,
+                               unsigned long (*const current_time_us)())
+    : PERIOD_US(period_us_),
+      SPIN_US(spin_threshold_us_),
+      last_fire_us(0),
+      CURRENT_TIME_US(current_time_us)
+{
+}
+
+/**
+ * @brief Checks if a tick is due, spin-waiting for it if it is less than SPIN_US away
+ *
+ * @return true if the caller should run the tick now, false otherwise
+ */
+bool SchedulerClock::due()
+{
+    const uint32_t delta = CURRENT_TIME_US() - last_fire_us;
+    if (delta >= PERIOD_US)
+    {
+        if (delta >= 2 * PERIOD_US)
+            // we missed more than one period, override last_fire_us to avoid bursts
+            last_fire_us = CURRENT_TIME_US();
+        else
+            last_fire_us += PERIOD_US;
+        return true;
+    }
+    // not time yet, check if we should spin-wait or return
+    if (delta >= PERIOD_US - SPIN_US)
+    {
+        // spin-wait
+        while ((uint32_t)(CURRENT_TIME_US() - last_fire_us) < PERIOD_US)
+            ;
+        last_fire_us += PERIOD_US;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Time since the tick that due() last returned was due, for SchedulerStats
+ *
+ * @return Lateness in microseconds
+ */
+uint32_t SchedulerClock::lateUs() const
+{
+    return CURRENT_TIME_US() - last_fire_us;
+}
+
+/**
+ * @brief Synchonize the ticks to the current time, used when starting multiple Schedulers across different boards together
+ *
+ * @param[in] current_time_us Function pointer to a function returning the current time in microseconds
+ */
+void SchedulerClock::synchronize(unsigned long (*const current_time_us)())
+{
+    if (current_time_us == nullptr)
+        return;
+    last_fire_us = current_time_us();
+}
@@ -0,0 +1,53 @@
+/**
+ * @file SchedulerClock.hpp
+ * @author Planeson, Red Bird Racing
+ * @brief Declaration of the SchedulerClock class, the tick timing shared by Scheduler and StaticScheduler
+ * @version 1.2
+ * @date 2026-10-16
+ * @see SchedulerClock.cpp, Scheduler.hpp, StaticScheduler.hpp, TimerClock.hpp
+ */
+
+#ifndef SCHEDULER_CLOCK_HPP
+#define SCHEDULER_CLOCK_HPP
+
+#include <stdint.h>
+
+/**
+ * @brief Decides when a scheduler tick fires, on a fixed period.
+ * @details When due() is called, it checks if a period has already passed.
+ * If not, it checks if it is almost passed. If the time to the next tick is less than SPIN_US, it spin-waits until the period is reached.
+ * Otherwise, it returns false immediately, allowing other non-scheduler tasks to run.
+ *
+ * In the rare case where the system is busy and misses more than one period, the tick restarts from now, preventing bursts.
+ *
+ * Accuracy depends on how often loop() calls due(), and up to SPIN_US of every period is spent spinning; see TimerClock for ticks from a hardware timer.
+ */
+class SchedulerClock
+{
+public:
+    SchedulerClock() = delete; /**< all arguments must be provided */
+    SchedulerClock(uint32_t period_us_, uint32_t spin_threshold_us_, unsigned long (*const current_time_us)());
+
+    /**
+     * @brief Nothing to start, micros() is already running.
+     * @return true
+     */
+    constexpr bool begin() const { return true; }
+    bool due();
+    uint32_t lateUs() const;
+    void synchronize(unsigned long (*const current_time_us)());
+
+    /**
+     * @brief Returns the period of the ticks in microseconds.
+     * @return The period in microseconds.
+     */
+    constexpr uint32_t getPeriodUs() const { return PERIOD_US; }
+
+private:
+    const uint32_t PERIOD_US;                 /**< Period (tick length). */
+    const uint32_t SPIN_US;                   /**< Threshold to switch from letting non-scheduler task in loop() run, to spin-locking (to ensure on time firing). */
+    uint32_t last_fire_us;                    /**< Last time a tick fired, overridden if missed more than one period. */
+    unsigned long (*const CURRENT_TIME_US)(); /**< Function pointer to a function returning the current time in microseconds. */
+};
+
+#endif // SCHEDULER_CLOCK_HPP
@@ -0,0 +1,64 @@
+/**
+ * @file SchedulerStats.hpp
+ * @author Planeson, Red Bird Racing
+ * @brief Declaration of the SchedulerStats class template, task and tick timing of a StaticScheduler
+ * @version 1.2
+ * @date 2026-10-16
+ * @see SchedulerStats.tpp, StaticScheduler.hpp
+ */
+
+#ifndef SCHEDULER_STATS_HPP
+#define SCHEDULER_STATS_HPP
+
+#include <stdint.h>
+
+constexpr uint8_t SCHEDULER_STATS_FRAME_BYTES = 8;   /**< Length of a payload built by SchedulerStats::nextFrame */
+constexpr uint8_t SCHEDULER_STATS_TICK_FRAME = 0xFF; /**< data[0] of the tick frame, task frames have the task index */
+
+/**
+ * @brief Execution time of each task and lateness and overruns of the ticks, sent over CAN one frame at a time.
+ * @details Only the payload is built here, so the scheduler headers don't need can.h, the caller picks the CAN ID. Every frame covers the time since that frame was last sent, and resets what it sent.
+ * Task frames: data[0] task index, data[1] runs, data[2-3] min, data[4-5] max, data[6-7] mean execution time in us.
+ * Tick frame: data[0] SCHEDULER_STATS_TICK_FRAME, data[1] overruns, data[2-3] max, data[4-5] mean lateness of the tick start in us,
+ * data[6-7] longest tick in us. Counts saturate at 255 and times at 65535us, little endian.
+ * An overrun is a tick whose tasks were still running when the next tick was due.
+ *
+ * @tparam NUM_TASKS Number of tasks in the table.
+ */
+template <uint8_t NUM_TASKS>
+class SchedulerStats
+{
+public:
+    SchedulerStats();
+
+    void task(uint8_t index, uint32_t duration_us);
+    void tick(uint32_t late_us, uint32_t busy_us, uint32_t period_us);
+    void nextFrame(uint8_t (&data)[SCHEDULER_STATS_FRAME_BYTES]);
+
+private:
+    /**
+     * @brief Execution time of one task
+     */
+    struct TaskStats
+    {
+        uint16_t min_us;   /**< Shortest run */
+        uint16_t max_us;   /**< Longest run */
+        uint32_t total_us; /**< Sum of all runs, for the mean */
+        uint16_t runs;     /**< Number of runs */
+    };
+
+    TaskStats tasks[NUM_TASKS]; /**< Per task, in table order */
+    uint16_t late_max_us;       /**< Latest tick start */
+    uint32_t late_total_us;     /**< Sum of the tick start lateness, for the mean */
+    uint16_t busy_max_us;       /**< Longest tick */
+    uint16_t ticks;             /**< Number of ticks */
+    uint16_t overruns;          /**< Ticks that ran into the next one */
+    uint8_t next_frame;         /**< Task index of the next frame, NUM_TASKS for the tick frame */
+
+    void resetTask(uint8_t index);
+    void resetTick();
+};
+
+#include "SchedulerStats.tpp"
+
+#endif // SCHEDULER_STATS_HPP
@@ -0,0 +1,143 @@
+/**
+ * @file SchedulerStats.tpp
+ * @author Planeson, Red Bird Racing
+ * @brief Implementation of the SchedulerStats class template
+ * @version 1.1
+ * @date 2026-10-16
+ * @see SchedulerStats.hpp
+ */
+
+#include "SchedulerStats.hpp" // SchedulerStats class template declaration
+
+/**
+ * @brief Saturates a time or count to 16 bits
+ * @param value Value to saturate
+ * @return value, at most UINT16_MAX
+ */
+constexpr uint16_t saturate16(const uint32_t value)
+{
+    return value > UINT16_MAX ? UINT16_MAX : static_cast<uint16_t>(value);
+}
+
+/**
+ * @brief Construct a new SchedulerStats object, with nothing recorded
+ *
+ * @tparam NUM_TASKS Number of tasks in the table
+ */
+template <uint8_t NUM_TASKS>
+SchedulerStats<NUM_TASKS>::SchedulerStats()
+    : next_frame(0)
+{
+    for (uint8_t i = 0; i < NUM_TASKS; ++i)
+        resetTask(i);
+    resetTick();
+}
+
+/**
+ * @brief Records one run of a task
+ *
+ * @tparam NUM_TASKS Number of tasks in the table
+ * @param index Index of the task in the table
+ * @param duration_us Execution time
+ */
+template <uint8_t NUM_TASKS>
+void SchedulerStats<NUM_TASKS>::task(const uint8_t index, const uint32_t duration_us)
+{
+    TaskStats &stats = tasks[index];
+    const uint16_t duration = saturate16(duration_us);
+    if (duration < stats.min_us)
+        stats.min_us = duration;
+    if (duration > stats.max_us)
+        stats.max_us = duration;
+    stats.total_us += duration;
+    if (stats.runs != UINT16_MAX)
+        ++stats.runs;
+}
+
+/**
+ * @brief Records one tick
+ *
+ * @tparam NUM_TASKS Number of tasks in the table
+ * @param late_us Time from when the tick was due to when its first task started
+ * @param busy_us Time from the first task starting to the last one returning
+ * @param period_us Period of the ticks
+ */
+template <uint8_t NUM_TASKS>
+void SchedulerStats<NUM_TASKS>::tick(const uint32_t late_us, const uint32_t busy_us, const uint32_t period_us)
+{
+    const uint16_t late = saturate16(late_us);
+    if (late > late_max_us)
+        late_max_us = late;
+    late_total_us += late;
+    if (busy_us > busy_max_us)
+        busy_max_us = saturate16(busy_us);
+    if (late_us + busy_us >= period_us && overruns != UINT16_MAX)
+        ++overruns;
+    if (ticks != UINT16_MAX)
+        ++ticks;
+}
+
+/**
+ * @brief Builds the payload of the next frame, going through the tasks then the tick, and resets what it covers
+ *
+ * @tparam NUM_TASKS Number of tasks in the table
+ * @param[out] data Payload of the frame
+ */
+template <uint8_t NUM_TASKS>
+void SchedulerStats<NUM_TASKS>::nextFrame(uint8_t (&data)[SCHEDULER_STATS_FRAME_BYTES])
+{
+    uint16_t fields[3];
+    if (next_frame < NUM_TASKS)
+    {
+        const TaskStats &stats = tasks[next_frame];
+        data[0] = next_frame;
+        data[1] = stats.runs > UINT8_MAX ? UINT8_MAX : static_cast<uint8_t>(stats.runs);
+        fields[0] = stats.runs == 0 ? 0 : stats.min_us;
+        fields[1] = stats.max_us;
+        fields[2] = stats.runs == 0 ? 0 : static_cast<uint16_t>(stats.total_us / stats.runs);
+        resetTask(next_frame);
+        ++next_frame;
+    }
+    else
+    {
+        data[0] = SCHEDULER_STATS_TICK_FRAME;
+        data[1] = overruns > UINT8_MAX ? UINT8_MAX : static_cast<uint8_t>(overruns);
+        fields[0] = late_max_us;
+        fields[1] = ticks == 0 ? 0 : static_cast<uint16_t>(late_total_us / ticks);
+        fields[2] = busy_max_us;
+        resetTick();
+        next_frame = 0;
+    }
+    for (uint8_t i = 0; i < 3; ++i)
+    {
+        data[2 + 2 * i] = static_cast<uint8_t>(fields[i] & 0xFF);
+        data[3 + 2 * i] = static_cast<uint8_t>(fields[i] >> 8);
+    }
+}
+
+/**
+ * @brief Clears the execution time of a task
+ *
+ * @tparam NUM_TASKS Number of tasks in the table
+ * @param index Index of the task in the table
+ */
+template <uint8_t NUM_TASKS>
+void SchedulerStats<NUM_TASKS>::resetTask(const uint8_t index)
+{
+    tasks[index] = TaskStats{UINT16_MAX, 0, 0, 0};
+}
+
+/**
+ * @brief Clears the tick statistics
+ *
+ * @tparam NUM_TASKS Number of tasks in the table
+ */
+template <uint8_t NUM_TASKS>
+void SchedulerStats<NUM_TASKS>::resetTick()
+{
+    late_max_us = 0;
+    late_total_us = 0;
+    busy_max_us = 0;
+    ticks = 0;
+    overruns = 0;
+}
@@ -0,0 +1,382 @@
+/**
+ * @file StaticScheduler.hpp
+ * @author Planeson, Red Bird Racing
+ * @brief Declaration of the StaticScheduler class template, a Scheduler with its task table fixed at compile time
+ * @version 1.6
+ * @date 2026-10-16
+ * @see StaticScheduler.tpp, Scheduler.hpp, SchedulerClock.hpp, TimerClock.hpp, SchedulerStats.hpp
+ */
+
+#ifndef STATIC_SCHEDULER_HPP
+#define STATIC_SCHEDULER_HPP
+
+#include <stdint.h>
+#include "Enums.hpp"
+#include "SchedulerClock.hpp"
+#include "TimerClock.hpp"
+#include "TaskPhase.hpp"
+
+#ifndef SCHEDULER_STATS
+#define SCHEDULER_STATS 0 // if 1, StaticScheduler times its tasks and ticks, else none of it is compiled in
+#endif
+
+#if SCHEDULER_STATS
+#include "SchedulerStats.hpp"
+#endif
+
+/**
+ * @brief One entry of a StaticScheduler task table.
+ * @tparam FN Task to run.
+ * @tparam MCP MCP2515 the task uses, for documentation and ordering the table.
+ * @tparam INTERVAL Number of ticks between runs, 1 for every tick, 0 to leave the task out at compile time (e.g. behind a debug flag).
+ * @tparam DYNAMIC false for a task that always runs, true for one started and stopped with enable()/disable(), disabled at first.
+ * @tparam PHASE Tick of the first run, below INTERVAL, or TASK_AUTO_PHASE to spread the multi-tick tasks over the ticks.
+ * @tparam PRIORITY What happens to the task when a tick runs over budget, see TaskPriority.
+ */
+template <void (*FN)(), McpIndex MCP, uint16_t INTERVAL, bool DYNAMIC = false, uint16_t PHASE = TASK_AUTO_PHASE, TaskPriority PRIORITY = TaskPriority::Normal>
+struct StaticTask
+{
+    static_assert(PHASE == TASK_AUTO_PHASE || INTERVAL == 0 || PHASE < INTERVAL, "StaticTask phase must be below its interval");
+    static constexpr void (*FUNCTION)() = FN;            /**< Task to run */
+    static constexpr McpIndex MCP_INDEX = MCP;           /**< MCP2515 the task uses */
+    static constexpr uint16_t TICK_INTERVAL = INTERVAL;  /**< Ticks between runs */
+    static constexpr uint32_t PERIOD_US = 0;             /**< 0, the interval is in ticks of the clock */
+    static constexpr bool IS_DYNAMIC = DYNAMIC;          /**< Whether the task has an enable bit */
+    static constexpr uint16_t TICK_PHASE = PHASE;        /**< Tick of the first run, or TASK_AUTO_PHASE */
+    static constexpr TaskPriority TASK_PRIORITY = PRIORITY; /**< Order and load shedding */
+};
+
+/**
+ * @brief One entry of a multi-rate StaticScheduler task table, with its period in microseconds instead of ticks.
+ * A table of RateTasks runs on a base tick computed at compile time, see StaticScheduler::BASE_PERIOD_US; it can't be mixed with StaticTasks.
+ * The phase is always picked automatically.
+ * @tparam FN Task to run.
+ * @tparam MCP MCP2515 the task uses, for documentation and ordering the table.
+ * @tparam PERIOD Microseconds between runs, 0 to leave the task out at compile time.
+ * @tparam DYNAMIC false for a task that always runs, true for one started and stopped with enable()/disable(), disabled at first.
+ * @tparam PRIORITY What happens to the task when a tick runs over budget, see TaskPriority.
+ */
+template <void (*FN)(), McpIndex MCP, uint32_t PERIOD, bool DYNAMIC = false, TaskPriority PRIORITY = TaskPriority::Normal>
+struct RateTask
+{
+    static constexpr void (*FUNCTION)() = FN;               /**< Task to run */
+    static constexpr McpIndex MCP_INDEX = MCP;              /**< MCP2515 the task uses */
+    static constexpr uint16_t TICK_INTERVAL = 0;            /**< 0, the interval follows from PERIOD_US and the base tick */
+    static constexpr uint32_t PERIOD_US = PERIOD;           /**< Microseconds between runs */
+    static constexpr bool IS_DYNAMIC = DYNAMIC;             /**< Whether the task has an enable bit */
+    static constexpr uint16_t TICK_PHASE = TASK_AUTO_PHASE; /**< Always picked automatically */
+    static constexpr TaskPriority TASK_PRIORITY = PRIORITY; /**< Order and load shedding */
+};
+
+/**
+ * @brief StaticTask that runs before all others and is never shed, e.g. the torque command.
+ */
+template <void (*FN)(), McpIndex MCP, uint16_t INTERVAL = 1>
+using CriticalTask = StaticTask<FN, MCP, INTERVAL, false, TASK_AUTO_PHASE, TaskPriority::Critical>;
+
+/**
+ * @brief StaticTask that is skipped when the tick is over budget, e.g. telemetry that is sent again soon anyway.
+ */
+template <void (*FN)(), McpIndex MCP, uint16_t INTERVAL = 1, uint16_t PHASE = TASK_AUTO_PHASE>
+using LowPriorityTask = StaticTask<FN, MCP, INTERVAL, false, PHASE, TaskPriority::Low>;
+
+/**
+ * @brief Base tick of a multi-rate task table, the greatest common divisor of the RateTask periods.
+ * Every period is a whole number of base ticks, and no longer tick divides them all.
+ * @tparam TASKS StaticTask or RateTask entries, in dispatch order.
+ * @return Base tick in microseconds, 0 for a table of StaticTasks.
+ */
+template <typename... TASKS>
+constexpr uint32_t staticBasePeriodUs()
+{
+    const uint32_t periods[sizeof...(TASKS)] = {TASKS::PERIOD_US...};
+    uint32_t base_us = 0;
+    for (uint8_t i = 0; i < sizeof...(TASKS); ++i)
+        base_us = intervalGcd(base_us, periods[i]);
+    return base_us;
+}
+
+/**
+ * @brief Checks that a task table doesn't mix StaticTasks and RateTasks, entries left out don't count.
+ * @tparam TASKS StaticTask or RateTask entries, in dispatch order.
+ * @return true if all entries have their interval in ticks, or all in microseconds.
+ */
+template <typename... TASKS>
+constexpr bool staticTableUnmixed()
+{
+    const uint16_t intervals[sizeof...(TASKS)] = {TASKS::TICK_INTERVAL...};
+    const uint32_t periods[sizeof...(TASKS)] = {TASKS::PERIOD_US...};
+    bool in_ticks = false;
+    bool in_us = false;
+    for (uint8_t i = 0; i < sizeof...(TASKS); ++i)
+    {
+        in_ticks = in_ticks || intervals[i] != 0;
+        in_us = in_us || periods[i] != 0;
+    }
+    return !(in_ticks && in_us);
+}
+
+/**
+ * @brief Ticks between runs of a task table entry.
+ * @tparam TASK StaticTask or RateTask entry.
+ * @tparam BASE_US Base tick of the table, see staticBasePeriodUs().
+ * @return TICK_INTERVAL of a StaticTask, the period in base ticks of a RateTask, 0 if it is left out.
+ */
+template <typename TASK, uint32_t BASE_US>
+constexpr uint32_t staticTaskInterval()
+{
+    return TASK::PERIOD_US == 0 ? TASK::TICK_INTERVAL : TASK::PERIOD_US / BASE_US;
+}
+
+/**
+ * @brief Tick of the first run of every task in a StaticScheduler table.
+ * @tparam NUM_TASKS Number of entries in the table.
+ */
+template <uint8_t NUM_TASKS>
+struct StaticTaskPhases
+{
+    uint16_t phase[NUM_TASKS]; /**< Phase of each task, in table order, 0 for tasks run every tick */
+};
+
+/**
+ * @brief Resolves the phases of a task table at compile time.
+ * Fixed phases are kept. TASK_AUTO_PHASE tasks are placed from the shortest interval up, each on the phase that meets
+ * the fewest already placed multi-tick tasks on its MCP2515, then on any MCP2515, then the earliest.
+ * @tparam BASE_US Base tick of the table, see staticBasePeriodUs().
+ * @tparam TASKS StaticTask or RateTask entries, in dispatch order.
+ * @return Phase of every task.
+ */
+template <uint32_t BASE_US, typename... TASKS>
+constexpr StaticTaskPhases<sizeof...(TASKS)> staticTaskPhases()
+{
+    constexpr uint8_t NUM_TASKS = sizeof...(TASKS);
+    const uint16_t intervals[NUM_TASKS] = {static_cast<uint16_t>(staticTaskInterval<TASKS, BASE_US>())...};
+    const uint8_t mcps[NUM_TASKS] = {static_cast<uint8_t>(TASKS::MCP_INDEX)...};
+    const uint16_t requested[NUM_TASKS] = {TASKS::TICK_PHASE...};
+    StaticTaskPhases<NUM_TASKS> phases = {};
+    bool placed[NUM_TASKS] = {};
+
+    for (uint8_t i = 0; i < NUM_TASKS; ++i)
+    {
+        // every tick or left out: phase 0, and nothing to avoid
+        placed[i] = intervals[i] <= 1;
+        if (intervals[i] > 1 && requested[i] != TASK_AUTO_PHASE)
+        {
+            phases.phase[i] = requested[i];
+            placed[i] = true;
+        }
+    }
+    for (uint8_t round = 0; round < NUM_TASKS; ++round)
+    {
+        // shortest interval not placed yet, the first in the table on ties
+        uint8_t next = NUM_TASKS;
+        for (uint8_t i = 0; i < NUM_TASKS; ++i)
+        {
+            if (!placed[i] && (next == NUM_TASKS || intervals[i] < intervals[next]))
+                next = i;
+        }
+        if (next == NUM_TASKS)
+            break;
+
+        uint16_t best_cost = UINT16_MAX;
+        for (uint16_t phase = 0; phase < intervals[next]; ++phase)
+        {
+            uint8_t same_mcp = 0;
+            uint8_t any_mcp = 0;
+            for (uint8_t j = 0; j < NUM_TASKS; ++j)
+            {
+                if (!placed[j] || intervals[j] <= 1 || !phasesCollide(phase, intervals[next], phases.phase[j], intervals[j]))
+                    continue;
+                ++any_mcp;
+                if (mcps[j] == mcps[next])
+                    ++same_mcp;
+            }
+            if (phaseCost(same_mcp, any_mcp) < best_cost)
+            {
+                best_cost = phaseCost(same_mcp, any_mcp);
+                phases.phase[next] = phase;
+            }
+        }
+        placed[next] = true;
+    }
+    return phases;
+}
+
+/**
+ * @brief Longest interval of a task table.
+ * @tparam BASE_US Base tick of the table, see staticBasePeriodUs().
+ * @tparam TASKS StaticTask or RateTask entries, in dispatch order.
+ * @return Largest number of ticks between runs of a task.
+ */
+template <uint32_t BASE_US, typename... TASKS>
+constexpr uint32_t staticMaxInterval()
+{
+    const uint32_t intervals[sizeof...(TASKS)] = {staticTaskInterval<TASKS, BASE_US>()...};
+    uint32_t max_interval = 0;
+    for (uint8_t i = 0; i < sizeof...(TASKS); ++i)
+    {
+        if (intervals[i] > max_interval)
+            max_interval = intervals[i];
+    }
+    return max_interval;
+}
+
+/**
+ * @brief Counter type of a StaticScheduler, one byte per task unless an interval needs two.
+ * @tparam WIDE true if an interval is above UINT8_MAX.
+ */
+template <bool WIDE>
+struct StaticTaskCounter
+{
+    using type = uint8_t; /**< Counter type */
+};
+
+/**
+ * @brief Counter type of a StaticScheduler with intervals above UINT8_MAX.
+ */
+template <>
+struct StaticTaskCounter<true>
+{
+    using type = uint16_t; /**< Counter type */
+};
+
+/**
+ * @brief Finds a task in a StaticScheduler task table by its function, at compile time.
+ * @tparam FN Task function to find.
+ * @tparam INDEX Index of the first entry of TASKS in the table.
+ * @tparam TASKS Rest of the table, StaticTask entries.
+ */
+template <void (*FN)(), uint8_t INDEX, typename... TASKS>
+struct StaticTaskIndex
+{
+    static constexpr uint8_t value = INDEX; /**< Index of FN, the table size if not found */
+    static constexpr bool dynamic = false;  /**< IS_DYNAMIC of the entry */
+};
+
+/**
+ * @brief Finds a task in a StaticScheduler task table by its function, checking TASK then REST.
+ * @tparam FN Task function to find.
+ * @tparam INDEX Index of TASK in the table.
+ * @tparam TASK Entry to check.
+ * @tparam REST Following entries.
+ */
+template <void (*FN)(), uint8_t INDEX, typename TASK, typename... REST>
+struct StaticTaskIndex<FN, INDEX, TASK, REST...>
+{
+    static constexpr uint8_t value = TASK::FUNCTION == FN ? INDEX : StaticTaskIndex<FN, INDEX + 1, REST...>::value;        /**< Index of FN, the table size if not found */
+    static constexpr bool dynamic = TASK::FUNCTION == FN ? TASK::IS_DYNAMIC : StaticTaskIndex<FN, INDEX + 1, REST...>::dynamic; /**< IS_DYNAMIC of the entry */
+};
+
+/**
+ * @brief Scheduler with the task table given as template arguments, dispatch unrolled at compile time.
+ * @details Ticks come from CLOCK, SchedulerClock for the spin-wait on micros() of Scheduler or TimerClock for a hardware timer. The tasks, their intervals and their order are StaticTask types,
+ * so runTasks is a straight sequence of calls: tasks run every tick are called directly,
+ * others decrement a counter, and only DYNAMIC tasks check their enable bit. Empty slots don't exist.
+ * Critical tasks run first, then the others, each in the order of the table, so interleave the MCP2515s in it to spread the load across the buses,
+ * as Scheduler does with its round-robin.
+ *
+ * Before each non-critical task, the time since the tick was due (CLOCK::lateUs()) is checked against the budget.
+ * Past it, a Normal task is deferred and tried again next tick even if not due, a Low task is dropped until it is next due;
+ * getDeferred() and getDropped() count them. After an overrun, this lets the next tick catch up with the critical tasks only.
+ *
+ * Tasks run every few ticks are staggered by their phase, so they don't all land on the same tick, see staticTaskPhases().
+ *
+ * A table of RateTasks is multi-rate: each task has its own period in microseconds, and the base tick BASE_PERIOD_US is
+ * their greatest common divisor, computed at compile time. CLOCK must be constructed with it, e.g. a 1 ms torque loop next to
+ * 1 s housekeeping wakes up every 1 ms, with housekeeping on one tick in 1000. Intervals above UINT8_MAX ticks widen the counters to 16 bits.
+ *
+ * Tasks that are only needed in some states (e.g. waiting for the BMS) are DYNAMIC and turned on and off with
+ * enable() and disable(), which only flip a bit, nothing is shifted. Their counter keeps running while disabled, so they keep their phase.
+ *
+ * With SCHEDULER_STATS, every task call and tick is timed with micros() into a SchedulerStats, sent with statsFrame().
+ *
+ * @tparam CLOCK Tick source, SchedulerClock or TimerClock.
+ * @tparam TASKS StaticTask entries, in dispatch order.
+ */
+template <typename CLOCK, typename... TASKS>
+class StaticScheduler
+{
+public:
+    static constexpr uint8_t TASK_COUNT = sizeof...(TASKS);                 /**< Number of entries in the table */
+    static constexpr uint32_t BASE_PERIOD_US = staticBasePeriodUs<TASKS...>(); /**< Tick a table of RateTasks needs from CLOCK, 0 for StaticTasks */
+
+    StaticScheduler() = delete; /**< all arguments must be provided */
+    explicit StaticScheduler(const CLOCK &clock_, uint32_t budget_us_ = UINT32_MAX);
+
+    bool begin();
+    void update();
+    void synchronize(unsigned long (*const current_time_us)());
+
+    template <void (*FN)()>
+    void enable();
+    template <void (*FN)()>
+    void disable();
+    template <void (*FN)()>
+    bool isEnabled() const;
+
+    /**
+     * @brief Returns the period of the scheduler in microseconds.
+     * @return The period in microseconds.
+     */
+    constexpr uint32_t getPeriodUs() const { return clock.getPeriodUs(); }
+
+    /**
+     * @brief Returns the tick of the first run of a task, phases repeat every interval from the first tick.
+     * @param[in] index Index of the task in the table.
+     * @return The phase in ticks.
+     */
+    static constexpr uint16_t getPhase(const uint8_t index) { return PHASES.phase[index]; }
+
+    /**
+     * @brief Returns the number of times a Normal task was deferred for being over budget.
+     * @return Deferrals, saturated at UINT16_MAX.
+     */
+    uint16_t getDeferred() const { return deferred; }
+
+    /**
+     * @brief Returns the number of times a Low task was dropped for being over budget.
+     * @return Drops, saturated at UINT16_MAX.
+     */
+    uint16_t getDropped() const { return dropped; }
+
+#if SCHEDULER_STATS
+    /**
+     * @brief Builds the payload of the next scheduler timing frame, see SchedulerStats::nextFrame.
+     * @param[out] data Payload of the frame to send on the datalogger bus.
+     */
+    void statsFrame(uint8_t (&data)[SCHEDULER_STATS_FRAME_BYTES]) { stats.nextFrame(data); }
+#endif
+
+private:
+    static_assert(TASK_COUNT > 0, "StaticScheduler needs at least one task");
+    static_assert(staticTableUnmixed<TASKS...>(), "StaticTask and RateTask can't be mixed in one table");
+    static_assert(staticMaxInterval<BASE_PERIOD_US, TASKS...>() <= UINT16_MAX, "RateTask period too long for the base tick, above UINT16_MAX ticks");
+    static constexpr StaticTaskPhases<TASK_COUNT> PHASES = staticTaskPhases<BASE_PERIOD_US, TASKS...>(); /**< Phase of every task */
+    using Counter = typename StaticTaskCounter<(staticMaxInterval<BASE_PERIOD_US, TASKS...>() > UINT8_MAX)>::type; /**< uint8_t, or uint16_t for long intervals */
+
+    Counter counters[TASK_COUNT];                 /**< Ticks left before each task fires, only used by tasks with an interval above 1 */
+    uint8_t enable_bits[(TASK_COUNT + 7) / 8];    /**< One bit per task in table order, only checked for DYNAMIC tasks */
+    uint8_t deferred_bits[(TASK_COUNT + 7) / 8];  /**< One bit per task in table order, set for Normal tasks waiting for the next tick */
+    uint16_t deferred;                            /**< Number of deferrals */
+    uint16_t dropped;                             /**< Number of drops */
+    const uint32_t BUDGET_US;                     /**< Non-critical tasks only start this long after the tick was due */
+    CLOCK clock;                                  /**< Decides when a tick fires */
+#if SCHEDULER_STATS
+    SchedulerStats<TASK_COUNT> stats;             /**< Task and tick timing */
+#endif
+
+    template <void (*FN)()>
+    static constexpr uint8_t dynamicIndex();
+    template <uint8_t INDEX, typename TASK>
+    inline void callTask();
+    template <uint8_t INDEX, typename TASK>
+    inline void runShedding(bool due);
+    template <bool CRITICAL, uint8_t INDEX, typename TASK, typename... REST>
+    inline void runTasks();
+    template <bool CRITICAL, uint8_t INDEX>
+    inline void runTasks();
+};
+
+#include "StaticScheduler.tpp"
+
+#endif // STATIC_SCHEDULER_HPP
@@ -0,0 +1,269 @@
+/**
+ * @file StaticScheduler.tpp
+ * @author Planeson, Red Bird Racing
+ * @brief Implementation of the StaticScheduler class template
+ * @version 1.5
+ * @date 2026-10-16
+ * @see StaticScheduler.hpp
+ */
+
+#include "StaticScheduler.hpp" // StaticScheduler class template declaration
+#if SCHEDULER_STATS
+#include <Arduino.h> // micros
+#endif
+
+template <typename CLOCK, typename... TASKS>
+constexpr StaticTaskPhases<StaticScheduler<CLOCK, TASKS...>::TASK_COUNT> StaticScheduler<CLOCK, TASKS...>::PHASES;
+
+/**
+ * @brief Construct a new StaticScheduler object
+ * Every task first runs on the tick of its phase, counted from 0 at the first tick, DYNAMIC tasks once enabled.
+ *
+ * @tparam CLOCK Tick source
+ * @tparam TASKS StaticTask entries, in dispatch order
+ * @param[in] clock_ Tick source, e.g. SchedulerClock(period_us, spin_threshold_us, micros), with a period of BASE_PERIOD_US for RateTasks
+ * @param[in] budget_us_ Time after a tick is due by which non-critical tasks must start, UINT32_MAX to never shed
+ */
+template <typename CLOCK, typename... TASKS>
+StaticScheduler<CLOCK, TASKS...>::StaticScheduler(const CLOCK &clock_, const uint32_t budget_us_)
+    : enable_bits{0},
+      deferred_bits{0},
+      deferred(0),
+      dropped(0),
+      BUDGET_US(budget_us_),
+      clock(clock_)
+{
+    for (uint8_t i = 0; i < TASK_COUNT; ++i)
+        counters[i] = PHASES.phase[i] + 1; // run on tick phase
+}
+
+/**
+ * @brief Start the tick source, call once in setup()
+ *
+ * @tparam CLOCK Tick source
+ * @tparam TASKS StaticTask entries, in dispatch order
+ * @return true if the clock started, false if it can't or doesn't tick at BASE_PERIOD_US for RateTasks
+ */
+template <typename CLOCK, typename... TASKS>
+bool StaticScheduler<CLOCK, TASKS...>::begin()
+{
+    if (BASE_PERIOD_US != 0 && clock.getPeriodUs() != BASE_PERIOD_US)
+        return false;
+    return clock.begin();
+}
+
+/**
+ * @brief Update the scheduler, running the task table if a tick is due
+ * With TimerClock and sleepIdle, sleeps until the next interrupt if no tick is pending.
+ *
+ * @tparam CLOCK Tick source
+ * @tparam TASKS StaticTask entries, in dispatch order
+ */
+template <typename CLOCK, typename... TASKS>
+void StaticScheduler<CLOCK, TASKS...>::update()
+{
+    if (!clock.due())
+        return;
+#if SCHEDULER_STATS
+    const uint32_t late_us = clock.lateUs();
+    const uint32_t start_us = micros();
+    runTasks<true, 0, TASKS...>();
+    runTasks<false, 0, TASKS...>();
+    stats.tick(late_us, micros() - start_us, clock.getPeriodUs());
+#else
+    runTasks<true, 0, TASKS...>();
+    runTasks<false, 0, TASKS...>();
+#endif
+}
+
+/**
+ * @brief Synchonize the scheduler to the current time, resetting all task counters, used when starting multiple Schedulers across different boards together
+ *
+ * @tparam CLOCK Tick source
+ * @tparam TASKS StaticTask entries, in dispatch order
+ * @param[in] current_time_us Function pointer to a function returning the current time in microseconds
+ */
+template <typename CLOCK, typename... TASKS>
+void StaticScheduler<CLOCK, TASKS...>::synchronize(unsigned long (*const current_time_us)())
+{
+    if (current_time_us == nullptr)
+        return;
+
+    clock.synchronize(current_time_us);
+    for (uint8_t i = 0; i < TASK_COUNT; ++i)
+        counters[i] = PHASES.phase[i] + 1;
+}
+
+/**
+ * @brief Index of a DYNAMIC task in the table, fails to compile for other functions
+ *
+ * @tparam CLOCK Tick source
+ * @tparam TASKS StaticTask entries, in dispatch order
+ * @tparam FN Task function
+ * @return Index of FN in TASKS
+ */
+template <typename CLOCK, typename... TASKS>
+template <void (*FN)()>
+constexpr uint8_t StaticScheduler<CLOCK, TASKS...>::dynamicIndex()
+{
+    static_assert(StaticTaskIndex<FN, 0, TASKS...>::value < TASK_COUNT, "task is not in the StaticScheduler table");
+    static_assert(StaticTaskIndex<FN, 0, TASKS...>::dynamic, "only DYNAMIC tasks can be enabled and disabled");
+    return StaticTaskIndex<FN, 0, TASKS...>::value;
+}
+
+/**
+ * @brief Start running a DYNAMIC task, from its next phase tick
+ *
+ * @tparam CLOCK Tick source
+ * @tparam TASKS StaticTask entries, in dispatch order
+ * @tparam FN Task function, must be a DYNAMIC entry of the table
+ */
+template <typename CLOCK, typename... TASKS>
+template <void (*FN)()>
+void StaticScheduler<CLOCK, TASKS...>::enable()
+{
+    constexpr uint8_t INDEX = dynamicIndex<FN>();
+    enable_bits[INDEX / 8] |= static_cast<uint8_t>(1u << (INDEX % 8));
+}
+
+/**
+ * @brief Stop running a DYNAMIC task
+ *
+ * @tparam CLOCK Tick source
+ * @tparam TASKS StaticTask entries, in dispatch order
+ * @tparam FN Task function, must be a DYNAMIC entry of the table
+ */
+template <typename CLOCK, typename... TASKS>
+template <void (*FN)()>
+void StaticScheduler<CLOCK, TASKS...>::disable()
+{
+    constexpr uint8_t INDEX = dynamicIndex<FN>();
+    enable_bits[INDEX / 8] &= static_cast<uint8_t>(~(1u << (INDEX % 8)));
+    deferred_bits[INDEX / 8] &= static_cast<uint8_t>(~(1u << (INDEX % 8)));
+}
+
+/**
+ * @brief Check if a DYNAMIC task is running
+ *
+ * @tparam CLOCK Tick source
+ * @tparam TASKS StaticTask entries, in dispatch order
+ * @tparam FN Task function, must be a DYNAMIC entry of the table
+ * @return true if enabled
+ */
+template <typename CLOCK, typename... TASKS>
+template <void (*FN)()>
+bool StaticScheduler<CLOCK, TASKS...>::isEnabled() const
+{
+    constexpr uint8_t INDEX = dynamicIndex<FN>();
+    return (enable_bits[INDEX / 8] & (1u << (INDEX % 8))) != 0;
+}
+
+/**
+ * @brief Calls task INDEX, timing it with SCHEDULER_STATS
+ *
+ * @tparam CLOCK Tick source
+ * @tparam TASKS StaticTask entries, in dispatch order
+ * @tparam INDEX Index of TASK in the table
+ * @tparam TASK Entry to call
+ */
+template <typename CLOCK, typename... TASKS>
+template <uint8_t INDEX, typename TASK>
+inline void StaticScheduler<CLOCK, TASKS...>::callTask()
+{
+#if SCHEDULER_STATS
+    const uint32_t start_us = micros();
+    TASK::FUNCTION();
+    stats.task(INDEX, micros() - start_us);
+#else
+    TASK::FUNCTION();
+#endif
+}
+
+/**
+ * @brief Runs non-critical task INDEX if it is due or deferred and the tick is within budget, else defers or drops it
+ *
+ * @tparam CLOCK Tick source
+ * @tparam TASKS StaticTask entries, in dispatch order
+ * @tparam INDEX Index of TASK in the table
+ * @tparam TASK Entry to run, Normal or Low priority
+ * @param[in] due true if the task is due this tick
+ */
+template <typename CLOCK, typename... TASKS>
+template <uint8_t INDEX, typename TASK>
+inline void StaticScheduler<CLOCK, TASKS...>::runShedding(const bool due)
+{
+    constexpr uint8_t BIT = static_cast<uint8_t>(1u << (INDEX % 8));
+    const bool waiting = TASK::TASK_PRIORITY == TaskPriority::Normal && (deferred_bits[INDEX / 8] & BIT);
+    if (!due && !waiting)
+        return;
+
+    if (BUDGET_US == UINT32_MAX || clock.lateUs() < BUDGET_US)
+    {
+        callTask<INDEX, TASK>();
+        deferred_bits[INDEX / 8] &= static_cast<uint8_t>(~BIT);
+    }
+    else if (TASK::TASK_PRIORITY == TaskPriority::Normal)
+    {
+        deferred_bits[INDEX / 8] |= BIT; // a deferred task that comes due again still runs once
+        if (deferred != UINT16_MAX)
+            ++deferred;
+    }
+    else if (dropped != UINT16_MAX)
+    {
+        ++dropped;
+    }
+}
+
+/**
+ * @brief Runs task INDEX if it is due and of the priority of this pass, then the following tasks
+ * The conditions on the task's priority, interval and IS_DYNAMIC are constants, so only the checks a task needs are compiled in, none for an interval of 0.
+ *
+ * @tparam CLOCK Tick source
+ * @tparam TASKS StaticTask entries, in dispatch order
+ * @tparam CRITICAL true for the pass over critical tasks, false for the others
+ * @tparam INDEX Index of TASK in the table
+ * @tparam TASK Entry to run
+ * @tparam REST Following entries
+ */
+template <typename CLOCK, typename... TASKS>
+template <bool CRITICAL, uint8_t INDEX, typename TASK, typename... REST>
+inline void StaticScheduler<CLOCK, TASKS...>::runTasks()
+{
+    constexpr uint32_t INTERVAL = staticTaskInterval<TASK, BASE_PERIOD_US>();
+    if ((TASK::TASK_PRIORITY == TaskPriority::Critical) == CRITICAL && INTERVAL != 0)
+    {
+        bool due = true;
+        if (INTERVAL != 1)
+        {
+            // counts while disabled too, to stay on its phase
+            due = counters[INDEX] == 1;
+            if (due)
+                counters[INDEX] = INTERVAL;
+            else
+                --counters[INDEX];
+        }
+
+        if (!TASK::IS_DYNAMIC || (enable_bits[INDEX / 8] & (1u << (INDEX % 8))))
+        {
+            if (!CRITICAL)
+                runShedding<INDEX, TASK>(due);
+            else if (due)
+                callTask<INDEX, TASK>();
+        }
+    }
+    runTasks<CRITICAL, INDEX + 1, REST...>();
+}
+
+/**
+ * @brief End of the task recursion
+ *
+ * @tparam CLOCK Tick source
+ * @tparam TASKS StaticTask entries, in dispatch order
+ * @tparam CRITICAL Pass that ended
+ * @tparam INDEX One past the last task
+ */
+template <typename CLOCK, typename... TASKS>
+template <bool CRITICAL, uint8_t INDEX>
+inline void StaticScheduler<CLOCK, TASKS...>::runTasks()
+{
+}
@@ -0,0 +1,54 @@
+/**
+ * @file TaskPhase.hpp
+ * @author Planeson, Red Bird Racing
+ * @brief Phase offsets of multi-tick scheduler tasks, shared by Scheduler and StaticScheduler
+ * @version 1.1
+ * @date 2026-10-16
+ * @see Scheduler.hpp, StaticScheduler.hpp
+ */
+
+#ifndef TASK_PHASE_HPP
+#define TASK_PHASE_HPP
+
+#include <stdint.h>
+
+constexpr uint16_t TASK_AUTO_PHASE = 0xFFFF; /**< Phase argument asking the scheduler to pick the phase that collides least */
+
+/**
+ * @brief Greatest common divisor of two intervals, in ticks or microseconds
+ * @param a First interval
+ * @param b Second interval, gcd(a, 0) is a
+ * @return gcd(a, b)
+ */
+constexpr uint32_t intervalGcd(const uint32_t a, const uint32_t b)
+{
+    return b == 0 ? a : intervalGcd(b, a % b);
+}
+
+/**
+ * @brief Checks if two periodic tasks ever fire on the same tick.
+ * A task fires on ticks phase + k * interval, two of them meet iff their phases are equal modulo the gcd of their intervals.
+ * @param phase_a Tick of the first run of the first task
+ * @param interval_a Ticks between its runs, not 0
+ * @param phase_b Tick of the first run of the second task
+ * @param interval_b Ticks between its runs, not 0
+ * @return true if they share ticks
+ */
+constexpr bool phasesCollide(const uint16_t phase_a, const uint16_t interval_a, const uint16_t phase_b, const uint16_t interval_b)
+{
+    return phase_a % intervalGcd(interval_a, interval_b) == phase_b % intervalGcd(interval_a, interval_b);
+}
+
+/**
+ * @brief Cost of giving a task a phase: tasks on its MCP2515 it meets first, then tasks on any MCP2515.
+ * Tasks run every tick meet everything and are left out by the caller.
+ * @param same_mcp Number of multi-tick tasks on the same MCP2515 sharing ticks with it
+ * @param any_mcp Number of multi-tick tasks on any MCP2515 sharing ticks with it
+ * @return Cost, lower is better
+ */
+constexpr uint16_t phaseCost(const uint8_t same_mcp, const uint8_t any_mcp)
+{
+    return static_cast<uint16_t>(same_mcp) << 8 | any_mcp;
+}
+
+#endif // TASK_PHASE_HPP
@@ -0,0 +1,184 @@
+/**
+ * @file TimerClock.cpp
+ * @author Planeson, Red Bird Racing
+ * @brief Implementation of the TimerClock class
+ * @version 1.1
+ * @date 2026-10-16
+ * @see TimerClock.hpp
+ */
+
+#include "TimerClock.hpp"
+
+volatile uint8_t TimerClock::pending = 0;
+
+#ifdef __AVR__
+#include <Arduino.h>
+#include <avr/sleep.h>
+
+/**
+ * @brief Timer1 compare match A interrupt, marks a tick.
+ */
+ISR(TIMER1_COMPA_vect)
+{
+    TimerClock::handleInterrupt();
+}
+
+/**
+ * @brief Starts Timer1 in CTC mode with a compare match every PERIOD_US.
+ * The first tick is one period from now. Call once in setup().
+ * @return true if started, false if the period doesn't fit Timer1 at TIMER_CLOCK_PRESCALER
+ */
+bool TimerClock::begin()
+{
+    static_assert(TIMER_CLOCK_PRESCALER == 64, "TCCR1B clock select below is for prescaler 64");
+    const uint32_t counts = static_cast<uint32_t>(static_cast<uint64_t>(F_CPU / TIMER_CLOCK_PRESCALER) * PERIOD_US / 1000000);
+    if (counts == 0 || counts > 65536)
+        return false;
+
+    noInterrupts();
+    TCCR1A = 0;
+    TCCR1B = _BV(WGM12) | _BV(CS11) | _BV(CS10); // CTC on OCR1A, prescaler 64
+    OCR1A = static_cast<uint16_t>(counts - 1);
+    TCNT1 = 0;
+    TIFR1 = _BV(OCF1A); // writing a 1 clears a stale flag
+    TIMSK1 = _BV(OCIE1A);
+    pending = 0;
+    interrupts();
+    return true;
+}
+
+/**
+ * @brief Sleeps in SLEEP_MODE_IDLE until the next interrupt, unless a tick is already pending.
+ * Pass to the constructor to sleep between ticks. Timers, ADC and pin change interrupts keep running.
+ */
+void TimerClock::sleepIdle()
+{
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    noInterrupts();
+    if (pending == 0)
+    {
+        sleep_enable();
+        interrupts(); // sei takes effect after the next instruction, so the tick can't slip in before sleep_cpu
+        sleep_cpu();
+        sleep_disable();
+    }
+    interrupts();
+}
+
+/**
+ * @brief Time since the tick that due() last returned was due, for load shedding and SchedulerStats
+ * Timer1 restarts from 0 on every match, so every match since then adds a period, also one whose interrupt hasn't run yet.
+ * Ticks missed before due() aren't counted, the tick restarts from the last match as with SchedulerClock.
+ *
+ * @return Lateness in microseconds
+ */
+uint32_t TimerClock::lateUs() const
+{
+    noInterrupts();
+    uint8_t periods = pending;
+    uint16_t counts = TCNT1;
+    if (TIFR1 & _BV(OCF1A))
+    {
+        // matched with interrupts off, read again as TCNT1 may have restarted after the first read
+        ++periods;
+        counts = TCNT1;
+    }
+    interrupts();
+    return periods * PERIOD_US + static_cast<uint32_t>(counts) * TIMER_CLOCK_PRESCALER / (F_CPU / 1000000UL);
+}
+
+/**
+ * @brief Restarts the period from now and drops pending ticks, used when starting multiple Schedulers across different boards together
+ *
+ * @param[in] current_time_us Unused, the timer keeps its own time
+ */
+void TimerClock::synchronize(unsigned long (*const current_time_us)())
+{
+    (void)current_time_us;
+    noInterrupts();
+    TCNT1 = 0;
+    TIFR1 = _BV(OCF1A);
+    pending = 0;
+    interrupts();
+}
+
+/**
+ * @brief Takes the pending ticks
+ * @return Number of ticks since the last call, saturated at 255
+ */
+uint8_t TimerClock::takePending()
+{
+    noInterrupts();
+    const uint8_t ticks = pending;
+    pending = 0;
+    interrupts();
+    return ticks;
+}
+#else
+// host builds drive the clock by calling handleInterrupt() from a simulated timer
+
+bool TimerClock::begin()
+{
+    return true;
+}
+
+void TimerClock::sleepIdle()
+{
+}
+
+uint32_t TimerClock::lateUs() const
+{
+    return pending * PERIOD_US; // no counter to read between simulated matches
+}
+
+void TimerClock::synchronize(unsigned long (*const current_time_us)())
+{
+    (void)current_time_us;
+    pending = 0;
+}
+
+uint8_t TimerClock::takePending()
+{
+    const uint8_t ticks = pending;
+    pending = 0;
+    return ticks;
+}
+#endif // __AVR__
+
+/**
+ * @brief Construct a new TimerClock object, Timer1 is only started by begin()
+ *
+ * @param[in] period_us_ Period of the ticks in microseconds, must fit 65536 Timer1 counts at TIMER_CLOCK_PRESCALER
+ * @param[in] idle_fn Called when no tick is pending, sleepIdle to sleep or nullptr to return to loop()
+ */
+TimerClock::TimerClock(const uint32_t period_us_, void (*const idle_fn)())
+    : PERIOD_US(period_us_),
+      IDLE_FN(idle_fn)
+{
+}
+
+/**
+ * @brief Checks if a tick is pending, idling once first if none is
+ *
+ * @return true if the caller should run the tick now, false otherwise
+ */
+bool TimerClock::due()
+{
+    uint8_t ticks = takePending();
+    if (ticks == 0 && IDLE_FN != nullptr)
+    {
+        IDLE_FN();
+        ticks = takePending();
+    }
+    // more than one tick pending means we missed some, run once to avoid bursts
+    return ticks != 0;
+}
+
+/**
+ * @brief Called from the compare match interrupt, marks a tick as pending.
+ */
+void TimerClock::handleInterrupt()
+{
+    if (pending != UINT8_MAX)
+        pending = pending + 1;
+}
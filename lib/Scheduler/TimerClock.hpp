@@ -0,0 +1,59 @@
+/**
+ * @file TimerClock.hpp
+ * @author Planeson, Red Bird Racing
+ * @brief Declaration of the TimerClock class, scheduler ticks from a hardware timer compare interrupt
+ * @version 1.1
+ * @date 2026-10-16
+ * @see TimerClock.cpp, SchedulerClock.hpp, StaticScheduler.hpp
+ */
+
+#ifndef TIMER_CLOCK_HPP
+#define TIMER_CLOCK_HPP
+
+#include <stdint.h>
+
+constexpr uint16_t TIMER_CLOCK_PRESCALER = 64; /**< Timer1 prescaler, 4us per count and periods up to 262ms at 16MHz */
+
+/**
+ * @brief Decides when a scheduler tick fires, from the Timer1 compare match interrupt.
+ * @details Timer1 runs in CTC mode and its compare interrupt marks a tick as pending, nothing else runs in the interrupt.
+ * due() takes the pending tick, so the tasks still run from loop() with interrupts on, next to the ADC and hall sensor interrupts.
+ * Unlike SchedulerClock, the tick is on the timer's grid however often loop() calls due(), and no time is spent spin-waiting.
+ *
+ * When no tick is pending, due() calls the idle function once if there is one:
+ * sleepIdle() puts the CPU in SLEEP_MODE_IDLE until the next interrupt, the tick or any other (ADC, millis(), hall edges), then checks again.
+ * With nullptr, due() returns false immediately and the rest of loop() gets the time between ticks for background work.
+ *
+ * If more than one tick passed before due() was called, they are taken as one, preventing bursts, and the grid is kept.
+ * lateUs() adds a period for every match since due() took the tick, so a task overrunning the next match still reads as late.
+ * Timer1 is used, so nothing else may use it (Servo, the cycle counter of test_benchmark).
+ */
+class TimerClock
+{
+public:
+    TimerClock() = delete; /**< all arguments must be provided */
+    TimerClock(uint32_t period_us_, void (*const idle_fn)());
+
+    bool begin();
+    bool due();
+    uint32_t lateUs() const;
+    void synchronize(unsigned long (*const current_time_us)());
+
+    /**
+     * @brief Returns the period of the ticks in microseconds.
+     * @return The period in microseconds.
+     */
+    constexpr uint32_t getPeriodUs() const { return PERIOD_US; }
+
+    static void handleInterrupt();
+    static void sleepIdle();
+
+private:
+    const uint32_t PERIOD_US;        /**< Period (tick length). */
+    void (*const IDLE_FN)();         /**< Called when no tick is pending, nullptr to return instead. */
+    static volatile uint8_t pending; /**< Ticks since due() last took one, written by the interrupt. */
+
+    static uint8_t takePending();
+};
+
+#endif // TIMER_CLOCK_HPP
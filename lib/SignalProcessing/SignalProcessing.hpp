@@ -2,10 +2,10 @@
  * @file SignalProcessing.hpp
  * @author Planeson, Red Bird Racing
  * @brief Declaration of signal processing functions
- * @version 2.1
- * @date 2026-01-28
+ * @version 3.7
+ * @date 2026-10-16
  * @see SignalProcessing.tpp
- * @dir SignalProcessing @brief The SignalProcessing library contains signal processing functions, including the AverageFilter and ExponentialFilter class templates for filtering ADC readings from the pedals.
+ * @dir SignalProcessing @brief The SignalProcessing library contains signal processing functions, including the AverageFilter, ExponentialFilter, PreciseExponentialFilter, MedianFilter and BiquadFilter class templates for filtering ADC readings from the pedals, FilterChain to combine them, and FilterBank to filter every input in one pass.
  */
 #ifndef SIGNAL_PROCESSING_HPP
 #define SIGNAL_PROCESSING_HPP
@@ -13,36 +13,135 @@
 #include <stdint.h>
 
 /**
- * @brief Abstract Base Class for signal filters.
+ * @brief Structure of a BiquadFilter.
+ */
+enum class BiquadForm : uint8_t
+{
+    DirectForm1 = 0,          /**< Integer input and output history, four delays */
+    DirectForm2Transposed = 1 /**< Two states with the fractional bits kept, fewer delays but needs the headroom of TypeAcc */
+};
+
+/**
+ * @brief Computes log2 of a power of two, for the shift fast paths of the filters
+ * @param value The power of two
+ * @return Its exponent
+ */
+constexpr uint8_t log2PowerOfTwo(const uint16_t value)
+{
+    return value <= 1 ? 0 : 1 + log2PowerOfTwo(value >> 1);
+}
+
+/**
+ * @brief Orders two values without a data-dependent branch, the compare-exchange of the median networks
+ * @tparam T Integer type of the values
+ * @param a Becomes the smaller value
+ * @param b Becomes the larger value
+ */
+template <typename T>
+inline void sortPair(T &a, T &b)
+{
+    const T swap = static_cast<T>((a ^ b) & static_cast<T>(-static_cast<T>(b < a)));
+    a = static_cast<T>(a ^ swap);
+    b = static_cast<T>(b ^ swap);
+}
+
+/**
+ * @brief Median of 3 or 5 values with the optimal sorting network, constant time
+ * @tparam T Integer type of the values
+ * @tparam SIZE Number of values, 3 or 5
+ * @param p The values, reordered in place
+ * @return The median
+ */
+template <typename T, uint8_t SIZE>
+inline T medianNetwork(T (&p)[SIZE])
+{
+    static_assert(SIZE == 3 || SIZE == 5, "only 3 and 5 value median networks are implemented");
+    if (SIZE == 3)
+    {
+        sortPair(p[0], p[1]);
+        sortPair(p[1], p[2]);
+        sortPair(p[0], p[1]);
+        return p[1];
+    }
+    // 5 values: only the middle of the network is needed, 7 compare-exchanges instead of 9 for a full sort
+    sortPair(p[0], p[1]);
+    sortPair(p[3], p[4]);
+    sortPair(p[0], p[3]);
+    sortPair(p[1], p[4]);
+    sortPair(p[1], p[2]);
+    sortPair(p[2], p[3]);
+    sortPair(p[1], p[2]);
+    return p[2];
+}
+
+/**
+ * @brief Static interface for signal filters (CRTP base).
  * Defines the interface for adding samples and retrieving filtered values.
+ * @details Every filter derives from Filter<itself, TypeInput> and implements addSampleImpl() and getFilteredImpl();
+ * calls are resolved at compile time, so there is no vtable and no vptr, and addSample() can be inlined into the caller.
+ * Filters are swapped by changing the declared type, code taking any filter takes a template parameter.
+ * @tparam Derived The filter class deriving from this.
  * @tparam TypeInput Type of the input samples.
- * @tparam TypeMid Type used for intermediate calculations.
+ * @tparam TypeOutput Type of the filtered value, the input type for every filter but FilterChain.
  */
-template <typename TypeInput, typename TypeMid>
+template <typename Derived, typename TypeInput, typename TypeOutput = TypeInput>
 class Filter
 {
 public:
-    virtual void addSample(TypeInput sample) = 0;
-    virtual TypeInput getFiltered() const = 0;
+    using Input = TypeInput;   /**< Type of the input samples, used by FilterChain */
+    using Output = TypeOutput; /**< Type of the filtered value, used by FilterChain */
+
+    /**
+     * @brief Adds a new sample to the filter.
+     * @param sample New input sample to add.
+     */
+    void addSample(TypeInput sample) { derived().addSampleImpl(sample); }
+
+    /**
+     * @brief Retrieves the filtered value.
+     * @return Filtered value.
+     */
+    TypeOutput getFiltered() const { return derived().getFilteredImpl(); }
+
+protected:
+    Filter() = default; /**< Only constructed as part of a derived filter */
+
+private:
+    Derived &derived() { return static_cast<Derived &>(*this); }                   /**< CRTP downcast */
+    const Derived &derived() const { return static_cast<const Derived &>(*this); } /**< CRTP downcast */
 };
 
 /**
  * @brief Filter with simple moving average algorithm.
+ * @details Keeps a running sum: each sample subtracts the oldest one and adds the newest, so both calls are O(1) for any SIZE.
+ * When SIZE is a power of two, the index wraps with a mask, and for an unsigned TypeMid the full average is a shift instead of a divide.
+ * Until SIZE samples have been added, the average is over the samples so far instead of counting the empty slots as zeros.
+ * The average is rounded toward zero, same as summing the buffer and dividing; a signed TypeMid keeps the divide, as a shift would round negative sums down.
  * @tparam TypeInput Type of the input samples.
- * @tparam TypeMid Type used for intermediate calculations.
+ * @tparam TypeMid Type used for intermediate calculations, must hold SIZE times the largest sample.
  * @tparam SIZE Number of samples to average over.
  */
 template <typename TypeInput, typename TypeMid, uint16_t SIZE>
-class AverageFilter : public Filter<TypeInput, TypeMid>
+class AverageFilter : public Filter<AverageFilter<TypeInput, TypeMid, SIZE>, TypeInput>
 {
+    static_assert(SIZE > 0, "AverageFilter needs at least one sample");
+    friend Filter<AverageFilter<TypeInput, TypeMid, SIZE>, TypeInput>;
+
 public:
     AverageFilter();
-    void addSample(TypeInput sample) override;
-    TypeInput getFiltered() const override;
 
 private:
-    TypeInput buffer[SIZE]; /**< Circular buffer for storing samples */
-    uint16_t index = 0;     /**< Current index in the circular buffer */
+    static constexpr bool POWER_OF_TWO = (SIZE & (SIZE - 1)) == 0; /**< Whether the index mask and the average shift can be used */
+    static constexpr bool SHIFT_AVERAGE = POWER_OF_TWO && static_cast<TypeMid>(-1) > 0; /**< Whether the full average can be a shift, rounding the same as the divide */
+    static constexpr uint8_t SIZE_SHIFT = log2PowerOfTwo(SIZE); /**< log2(SIZE), only used if SHIFT_AVERAGE */
+
+    TypeInput buffer[SIZE] = {}; /**< Circular buffer for storing samples */
+    TypeMid sum = 0;             /**< Sum of the samples in the buffer */
+    uint16_t index = 0;          /**< Current index in the circular buffer, the oldest sample once full */
+    uint16_t count = 0;          /**< Number of samples in the buffer, SIZE once warmed up */
+
+    void addSampleImpl(TypeInput sample);
+    TypeInput getFilteredImpl() const;
 };
 
 /**
@@ -50,23 +149,363 @@ private:
  * @details Old samples "decay" naturally. The formula used is:
  * f(t) = (f(t-1) * OLD_RATIO + sample * NEW_RATIO + (OLD_RATIO + NEW_RATIO) / 2) / (OLD_RATIO + NEW_RATIO)
  * Due to round down, the results won't ever reach maximum, especially if OLD_RATIO >> NEW_RATIO, so the use of curve is important.
+ * PreciseExponentialFilter doesn't have this problem.
  * @tparam TypeInput Type of the input samples.
- * @tparam TypeMid Type used for intermediate calculations.
+ * @tparam TypeMid Type used for intermediate calculations, must hold the largest sample times (OLD_RATIO + NEW_RATIO).
  * @tparam OLD_RATIO Weighting ratio for the old value.
  * @tparam NEW_RATIO Weighting ratio for the new sample.
  */
 template <typename TypeInput, typename TypeMid, uint8_t OLD_RATIO = 31, uint8_t NEW_RATIO = 1>
-class ExponentialFilter : public Filter<TypeInput, TypeMid>
+class ExponentialFilter : public Filter<ExponentialFilter<TypeInput, TypeMid, OLD_RATIO, NEW_RATIO>, TypeInput>
 {
+    friend Filter<ExponentialFilter<TypeInput, TypeMid, OLD_RATIO, NEW_RATIO>, TypeInput>;
+
 public:
     ExponentialFilter();
-    void addSample(TypeInput sample) override;
-    TypeInput getFiltered() const override;
 
 private:
     TypeInput last_out = 0; /**< Last output value for exponential filter, input for next calculation */
+
+    void addSampleImpl(TypeInput sample);
+    TypeInput getFilteredImpl() const;
+};
+
+/**
+ * @brief Exponential moving average with fractional state bits, settles all the way and has no steady-state bias.
+ * @details Same weighting as ExponentialFilter, but the state keeps FRACTION_BITS below the input LSB
+ * (16.16 fixed point for the defaults), so small steps aren't lost to rounding every sample.
+ * If OLD_RATIO + NEW_RATIO is a power of two, the update is shifts, multiplies by NEW_RATIO and adds only:
+ * state = state - (state >> k) * NEW_RATIO + (sample << (FRACTION_BITS - k)) * NEW_RATIO, with k = log2(OLD_RATIO + NEW_RATIO).
+ * Otherwise it falls back to a 64-bit multiply and divide, which is slow on AVR.
+ * The state settles exactly on a step up, and within OLD_RATIO + NEW_RATIO fractional LSB after a step down.
+ * getFiltered() rounds the state to nearest, getFilteredPrecise() returns the state itself.
+ * @tparam TypeInput Type of the input samples, unsigned.
+ * @tparam TypeState Type of the state, unsigned and at least FRACTION_BITS wider than TypeInput.
+ * @tparam OLD_RATIO Weighting ratio for the old value.
+ * @tparam NEW_RATIO Weighting ratio for the new sample.
+ * @tparam FRACTION_BITS Bits of state below the input LSB.
+ */
+template <typename TypeInput, typename TypeState = uint32_t, uint8_t OLD_RATIO = 31, uint8_t NEW_RATIO = 1, uint8_t FRACTION_BITS = 16>
+class PreciseExponentialFilter : public Filter<PreciseExponentialFilter<TypeInput, TypeState, OLD_RATIO, NEW_RATIO, FRACTION_BITS>, TypeInput>
+{
+    static_assert(static_cast<TypeInput>(-1) > 0 && static_cast<TypeState>(-1) > 0, "PreciseExponentialFilter needs unsigned types");
+    static_assert(sizeof(TypeInput) * 8 + FRACTION_BITS <= sizeof(TypeState) * 8, "TypeState must hold the largest sample shifted by FRACTION_BITS");
+    static_assert(FRACTION_BITS > 0 && NEW_RATIO > 0, "PreciseExponentialFilter needs fraction bits and a non-zero NEW_RATIO");
+    friend Filter<PreciseExponentialFilter<TypeInput, TypeState, OLD_RATIO, NEW_RATIO, FRACTION_BITS>, TypeInput>;
+
+public:
+    PreciseExponentialFilter();
+
+    /**
+     * @brief Retrieves the full-precision filtered value.
+     * @return Filtered value in fixed point, with fractionBits() bits below the input LSB.
+     */
+    TypeState getFilteredPrecise() const { return state; }
+
+    /**
+     * @brief Returns the number of fractional bits of getFilteredPrecise()
+     * @return FRACTION_BITS
+     */
+    static constexpr uint8_t fractionBits() { return FRACTION_BITS; }
+
+private:
+    static constexpr uint16_t RATIO_SUM = static_cast<uint16_t>(OLD_RATIO) + NEW_RATIO;        /**< Divisor of the weighting */
+    static constexpr bool POWER_OF_TWO = (RATIO_SUM & (RATIO_SUM - 1)) == 0;                   /**< Whether the update is shift-only */
+    static constexpr uint8_t RATIO_SHIFT = log2PowerOfTwo(RATIO_SUM); /**< log2(RATIO_SUM), only used if POWER_OF_TWO */
+    static_assert(!POWER_OF_TWO || RATIO_SHIFT <= FRACTION_BITS, "FRACTION_BITS must be at least log2(OLD_RATIO + NEW_RATIO)");
+
+    TypeState state = 0; /**< Filtered value in fixed point with FRACTION_BITS fractional bits */
+
+    void addSampleImpl(TypeInput sample);
+    TypeInput getFilteredImpl() const;
+};
+
+/**
+ * @brief Running median over the last 3 or 5 samples, rejects single (or double, with 5) sample spikes.
+ * @details The median is taken by medianNetwork(), compare-exchanges done with masks instead of branches,
+ * so every sample costs the same number of cycles whatever the data: 3 compare-exchanges for 3 taps, 7 for 5.
+ * The first sample fills the whole window, so the output never starts from 0 and trips a low range check.
+ * Delays the signal by SIZE / 2 samples. Use it before an ExponentialFilter in a FilterChain,
+ * and read the range checks from FilterChain::first().
+ * @tparam TypeInput Type of the input samples, integer.
+ * @tparam SIZE Number of taps, 3 or 5.
+ */
+template <typename TypeInput, uint8_t SIZE = 3>
+class MedianFilter : public Filter<MedianFilter<TypeInput, SIZE>, TypeInput>
+{
+    static_assert(SIZE == 3 || SIZE == 5, "MedianFilter only has sorting networks for 3 and 5 taps");
+    friend Filter<MedianFilter<TypeInput, SIZE>, TypeInput>;
+
+public:
+    MedianFilter();
+
+private:
+    TypeInput window[SIZE] = {}; /**< Last SIZE samples, oldest first */
+    TypeInput median = 0;        /**< Median of window, updated with every sample */
+    bool primed = false;         /**< Whether the first sample has filled the window */
+
+    void addSampleImpl(TypeInput sample);
+    TypeInput getFilteredImpl() const;
+};
+
+/**
+ * @brief Coefficients of a BiquadFilter, normalized so a0 is 1.
+ * y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+ * @tparam TypeCoeff Signed type of the coefficients, int16_t for Q2.14 or int32_t for Q2.30.
+ */
+template <typename TypeCoeff>
+struct BiquadCoefficients
+{
+    static constexpr uint8_t FRACTION_BITS = sizeof(TypeCoeff) * 8 - 2; /**< Coefficients are in (-2, 2), so 2 integer bits including sign */
+
+    TypeCoeff b0; /**< Feedforward, x[n] */
+    TypeCoeff b1; /**< Feedforward, x[n-1] */
+    TypeCoeff b2; /**< Feedforward, x[n-2] */
+    TypeCoeff a1; /**< Feedback, y[n-1] */
+    TypeCoeff a2; /**< Feedback, y[n-2] */
+};
+
+/**
+ * @brief Sine by its Taylor series, for compile-time filter design
+ * @param x Angle in radians, accurate in [-pi, pi]
+ * @return sin(x)
+ */
+constexpr double sinTaylor(const double x)
+{
+    double term = x;
+    double sum = x;
+    for (uint8_t n = 1; n < 12; ++n)
+    {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * @brief Cosine by its Taylor series, for compile-time filter design
+ * @param x Angle in radians, accurate in [-pi, pi]
+ * @return cos(x)
+ */
+constexpr double cosTaylor(const double x)
+{
+    double term = 1;
+    double sum = 1;
+    for (uint8_t n = 1; n < 12; ++n)
+    {
+        term *= -x * x / ((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * @brief Converts a coefficient to fixed point, rounded to nearest
+ * @tparam TypeCoeff Signed type of the coefficient
+ * @param value Coefficient, in (-2, 2)
+ * @return value in Q(BiquadCoefficients<TypeCoeff>::FRACTION_BITS)
+ */
+template <typename TypeCoeff>
+constexpr TypeCoeff toFixedCoefficient(const double value)
+{
+    return static_cast<TypeCoeff>(value * static_cast<double>(static_cast<uint32_t>(1) << BiquadCoefficients<TypeCoeff>::FRACTION_BITS) + (value >= 0 ? 0.5 : -0.5));
+}
+
+/**
+ * @brief Designs a second order low-pass at compile time (Audio EQ Cookbook, bilinear transform).
+ * b1 is adjusted after rounding so the DC gain is exactly 1 in fixed point, a constant input gives the same output.
+ * On AVR double is 32-bit, so Q2.30 coefficients only get float precision.
+ * @tparam TypeCoeff Signed type of the coefficients, int16_t or int32_t.
+ * @param cutoff_hz Cutoff (-3dB for q = 0.7071) frequency in Hz, below half the sample rate.
+ * @param q Quality factor, 0.7071 for Butterworth, higher peaks at the cutoff.
+ * @param period_us Sample period in microseconds, e.g. the scheduler period if the filter runs in a scheduler task.
+ * @return Coefficients in fixed point.
+ */
+template <typename TypeCoeff>
+constexpr BiquadCoefficients<TypeCoeff> biquadLowPass(const double cutoff_hz, const double q, const uint32_t period_us)
+{
+    const double w0 = 2 * 3.14159265358979323846 * cutoff_hz * period_us / 1000000.0;
+    const double cos_w0 = cosTaylor(w0);
+    const double alpha = sinTaylor(w0) / (2 * q);
+    const double a0 = 1 + alpha;
+    const TypeCoeff b0 = toFixedCoefficient<TypeCoeff>((1 - cos_w0) / 2 / a0);
+    const TypeCoeff a1 = toFixedCoefficient<TypeCoeff>(-2 * cos_w0 / a0);
+    const TypeCoeff a2 = toFixedCoefficient<TypeCoeff>((1 - alpha) / a0);
+    // b0 + b1 + b2 == 1 + a1 + a2 in fixed point
+    const int32_t one = static_cast<int32_t>(static_cast<uint32_t>(1) << BiquadCoefficients<TypeCoeff>::FRACTION_BITS);
+    const TypeCoeff b1 = static_cast<TypeCoeff>(one + a1 + a2 - 2 * b0);
+    return BiquadCoefficients<TypeCoeff>{b0, b1, b0, a1, a2};
+}
+
+/**
+ * @brief Second order IIR filter in fixed point, e.g. a low-pass with a sharper cutoff than ExponentialFilter for the same lag.
+ * @details Coefficients come from a constexpr design such as biquadLowPass(), so the floating point math is done by the compiler.
+ * Products are summed in TypeAcc, which must hold 5 times the largest sample times 2^FRACTION_BITS:
+ * int32_t is enough for 12-bit samples with int16_t coefficients, 16-bit samples or int32_t coefficients need int64_t.
+ * The output is rounded down and the remainder is added to the next sample (error feedback),
+ * so there is no dead band: a constant input gives exactly that output once settled.
+ * The output saturates to [0, largest TypeInput] for unsigned inputs (a resonant filter overshoots),
+ * and the saturated value is what is fed back, so it can't wrap or wind up.
+ * @tparam TypeInput Type of the input samples.
+ * @tparam TypeCoeff Signed type of the coefficients, int16_t (Q2.14) or int32_t (Q2.30).
+ * @tparam TypeAcc Signed type of the accumulator and states.
+ * @tparam FORM DirectForm1 or DirectForm2Transposed.
+ */
+template <typename TypeInput, typename TypeCoeff = int16_t, typename TypeAcc = int32_t, BiquadForm FORM = BiquadForm::DirectForm1>
+class BiquadFilter : public Filter<BiquadFilter<TypeInput, TypeCoeff, TypeAcc, FORM>, TypeInput>
+{
+    static_assert(static_cast<TypeCoeff>(-1) < 0 && static_cast<TypeAcc>(-1) < 0, "BiquadFilter needs signed coefficients and accumulator");
+    friend Filter<BiquadFilter<TypeInput, TypeCoeff, TypeAcc, FORM>, TypeInput>;
+
+public:
+    explicit BiquadFilter(const BiquadCoefficients<TypeCoeff> &coeffs_);
+
+private:
+    static constexpr uint8_t FRACTION_BITS = BiquadCoefficients<TypeCoeff>::FRACTION_BITS; /**< Fractional bits of the coefficients */
+
+    const BiquadCoefficients<TypeCoeff> coeffs; /**< Filter coefficients */
+    TypeAcc z[4] = {};                          /**< DirectForm1: x[n-1], x[n-2], y[n-1], y[n-2]; DirectForm2Transposed: s1, s2 */
+    TypeAcc error = 0;                          /**< Fractional part dropped from the last output, added to the next */
+    TypeInput out = 0;                          /**< Last output */
+
+    /**
+     * @brief Clamps an accumulator to the range of TypeInput
+     * @param value Value to clamp
+     * @return value, saturated
+     */
+    static TypeAcc saturate(const TypeAcc value)
+    {
+        constexpr TypeAcc MAX = static_cast<TypeInput>(-1) > 0 ? static_cast<TypeAcc>(static_cast<TypeInput>(-1)) : static_cast<TypeAcc>((static_cast<uint32_t>(1) << (sizeof(TypeInput) * 8 - 1)) - 1);
+        constexpr TypeAcc MIN = static_cast<TypeInput>(-1) > 0 ? 0 : -MAX - 1;
+        return value < MIN ? MIN : (value > MAX ? MAX : value);
+    }
+
+    void addSampleImpl(TypeInput sample);
+    TypeInput getFilteredImpl() const;
+};
+
+/**
+ * @brief Filters run one after another, composed at compile time, e.g. FilterChain<MedianFilter, ExponentialFilter>.
+ * @details Each sample goes through First, and First's output into the rest of the chain.
+ * The chain takes First's input type and gives the last stage's output type.
+ * Stages are plain members, so the chain costs exactly the RAM of its stages and every call inlines.
+ * @tparam First The first stage.
+ * @tparam Rest The following stages, in order; the last stage gives the chain's output.
+ */
+template <typename First, typename... Rest>
+class FilterChain : public Filter<FilterChain<First, Rest...>, typename First::Input, typename FilterChain<Rest...>::Output>
+{
+    friend Filter<FilterChain<First, Rest...>, typename First::Input, typename FilterChain<Rest...>::Output>;
+
+public:
+    FilterChain() = default;
+
+    /**
+     * @brief Returns the first stage, e.g. to read an intermediate output
+     * @return Reference to the first stage.
+     */
+    const First &first() const { return head; }
+
+    /**
+     * @brief Returns the chain of the following stages
+     * @return Reference to the rest of the chain.
+     */
+    const FilterChain<Rest...> &rest() const { return tail; }
+
+private:
+    First head;                /**< First stage */
+    FilterChain<Rest...> tail; /**< Following stages */
+
+    void addSampleImpl(typename First::Input sample);
+    typename FilterChain<Rest...>::Output getFilteredImpl() const;
+};
+
+/**
+ * @brief Last stage of a FilterChain, behaves exactly like First.
+ * @tparam First The only stage.
+ */
+template <typename First>
+class FilterChain<First> : public Filter<FilterChain<First>, typename First::Input, typename First::Output>
+{
+    friend Filter<FilterChain<First>, typename First::Input, typename First::Output>;
+
+public:
+    FilterChain() = default;
+
+    /**
+     * @brief Returns the only stage
+     * @return Reference to the stage.
+     */
+    const First &first() const { return head; }
+
+private:
+    First head; /**< The only stage */
+
+    void addSampleImpl(typename First::Input sample) { head.addSample(sample); }
+    typename First::Output getFilteredImpl() const { return head.getFiltered(); }
+};
+
+/**
+ * @brief Filters several ADC inputs in one pass, a 3 or 5 tap median then a shift-only exponential average per channel.
+ * @details Same results as FilterChain<MedianFilter<uint16_t, TAPS>, PreciseExponentialFilter<uint16_t, uint32_t, 2^SHIFT - 1, 1>>
+ * per channel, but the state is stored channel-contiguous (one array per state variable, indexed by channel),
+ * all channels are updated by one addSamples() call from one sample vector, and the per-channel loop is unrolled
+ * at compile time so every shift is a constant.
+ * getMedian() is meant for range checks, getFiltered() and snapshot() for control and telemetry.
+ * @tparam TAPS Taps of the median stage, 3 or 5, the same for every channel.
+ * @tparam SHIFTS Per channel, log2(OLD_RATIO + NEW_RATIO) of the exponential average with NEW_RATIO 1; 0 passes the median through.
+ */
+template <uint8_t TAPS, uint8_t... SHIFTS>
+class FilterBank
+{
+public:
+    static constexpr uint8_t CHANNELS = sizeof...(SHIFTS); /**< Number of channels */
+    static constexpr uint8_t FRACTION_BITS = 16;            /**< Bits of state below the input LSB */
+
+    FilterBank();
+
+    /**
+     * @brief Adds one sample to every channel.
+     * The first call fills the median windows.
+     * @param samples One sample per channel, in channel order.
+     */
+    void addSamples(const uint16_t (&samples)[CHANNELS]);
+
+    /**
+     * @brief Retrieves the filtered value of a channel, rounded to the nearest input LSB.
+     * @param channel Channel index.
+     * @return Filtered value.
+     */
+    uint16_t getFiltered(uint8_t channel) const;
+
+    /**
+     * @brief Retrieves the median stage output of a channel, spikes rejected but not smoothed.
+     * @param channel Channel index.
+     * @return Median of the last TAPS samples.
+     */
+    uint16_t getMedian(uint8_t channel) const { return median[channel]; }
+
+    /**
+     * @brief Copies every filtered value at once, e.g. for telemetry.
+     * @param out One filtered value per channel, in channel order.
+     */
+    void snapshot(uint16_t (&out)[CHANNELS]) const;
+
+private:
+    static_assert(CHANNELS > 0, "FilterBank needs at least one channel");
+    static_assert(TAPS == 3 || TAPS == 5, "FilterBank only has median networks for 3 and 5 taps");
+
+    uint16_t window[TAPS][CHANNELS] = {}; /**< Last TAPS samples of each channel, oldest first */
+    uint16_t median[CHANNELS] = {};       /**< Median stage output of each channel */
+    uint32_t state[CHANNELS] = {};        /**< Exponential average of each channel, FRACTION_BITS fixed point */
+    bool primed = false;                  /**< Whether the first samples have filled the windows */
+
+    template <uint8_t CHANNEL, uint8_t SHIFT, uint8_t... REST>
+    void updateChannels(const uint16_t (&samples)[CHANNELS]);
+    template <uint8_t CHANNEL>
+    void updateChannels(const uint16_t (&samples)[CHANNELS]);
 };
 
 #include "SignalProcessing.tpp" // implementation
 
-#endif // SIGNAL_PROCESSING_HPP
\ No newline at end of file
+#endif // SIGNAL_PROCESSING_HPP
@@ -2,8 +2,8 @@
  * @file SignalProcessing.tpp
  * @author Planeson, Red Bird Racing
  * @brief Definition of Signal Processing functions
- * @version 2.1
- * @date 2026-01-28
+ * @version 3.7
+ * @date 2026-10-16
  * @see Signal_Processing.hpp
  */
 
@@ -13,7 +13,7 @@
 
 /**
  * @brief Constructor for AverageFilter.
- * Initializes the circular buffer to zero.
+ * Initializes the circular buffer, sum and sample count to zero.
  * @tparam TypeInput Type of the input samples.
  * @tparam TypeMid Type used for intermediate calculations.
  * @tparam SIZE Number of samples to average over.
@@ -23,36 +23,43 @@ AverageFilter<TypeInput, TypeMid, SIZE>::AverageFilter() = default;
 
 /**
  * @brief Adds a new sample to the AverageFilter.
- * Stores the sample in the circular buffer and updates the index.
+ * Replaces the oldest sample in the circular buffer and the running sum, then advances the index.
  * @tparam TypeInput Type of the input samples.
  * @tparam TypeMid Type used for intermediate calculations.
  * @tparam SIZE Number of samples to average over.
  * @param sample New input sample to add.
  */
 template <typename TypeInput, typename TypeMid, uint16_t SIZE>
-void AverageFilter<TypeInput, TypeMid, SIZE>::addSample(TypeInput sample)
+void AverageFilter<TypeInput, TypeMid, SIZE>::addSampleImpl(TypeInput sample)
 {
+    if (count == SIZE)
+        sum -= buffer[index];
+    else
+        ++count;
     buffer[index] = sample;
-    index = (index + 1) % SIZE;
+    sum += sample;
+    if (POWER_OF_TWO)
+        index = (index + 1) & (SIZE - 1);
+    else
+        index = (index + 1 == SIZE) ? 0 : index + 1;
 }
 
 /**
  * @brief Retrieves the filtered value from the AverageFilter.
- * Computes the average of the samples in the circular buffer.
+ * Divides the running sum by the number of samples, a shift once warmed up if SHIFT_AVERAGE.
  * @tparam TypeInput Type of the input samples.
  * @tparam TypeMid Type used for intermediate calculations.
  * @tparam SIZE Number of samples to average over.
- * @return Filtered average value.
+ * @return Filtered average value, 0 before the first sample.
  */
 template <typename TypeInput, typename TypeMid, uint16_t SIZE>
-TypeInput AverageFilter<TypeInput, TypeMid, SIZE>::getFiltered() const
+TypeInput AverageFilter<TypeInput, TypeMid, SIZE>::getFilteredImpl() const
 {
-    TypeMid sum = 0;
-    for (uint16_t i = 0; i < SIZE; ++i)
-    {
-        sum += buffer[i];
-    }
-    return static_cast<TypeInput>(sum / static_cast<TypeMid>(SIZE));
+    if (SHIFT_AVERAGE && count == SIZE)
+        return static_cast<TypeInput>(sum >> SIZE_SHIFT);
+    if (count == 0)
+        return 0;
+    return static_cast<TypeInput>(sum / static_cast<TypeMid>(count));
 }
 
 // == ExponentialFilter ===
@@ -78,9 +85,10 @@ ExponentialFilter<TypeInput, TypeMid, OLD_RATIO, NEW_RATIO>::ExponentialFilter()
  * @param sample New input sample to add.
  */
 template <typename TypeInput, typename TypeMid, uint8_t OLD_RATIO, uint8_t NEW_RATIO>
-void ExponentialFilter<TypeInput, TypeMid, OLD_RATIO, NEW_RATIO>::addSample(TypeInput sample)
+void ExponentialFilter<TypeInput, TypeMid, OLD_RATIO, NEW_RATIO>::addSampleImpl(TypeInput sample)
 {
-    last_out = static_cast<TypeMid>(last_out * OLD_RATIO + sample * NEW_RATIO + (OLD_RATIO + NEW_RATIO) / 2) / (OLD_RATIO + NEW_RATIO);
+    // widen before multiplying, uint16_t operands would otherwise wrap in unsigned int on AVR
+    last_out = static_cast<TypeInput>((static_cast<TypeMid>(last_out) * OLD_RATIO + static_cast<TypeMid>(sample) * NEW_RATIO + (OLD_RATIO + NEW_RATIO) / 2) / (OLD_RATIO + NEW_RATIO));
 }
 
 /**
@@ -92,7 +100,297 @@ void ExponentialFilter<TypeInput, TypeMid, OLD_RATIO, NEW_RATIO>::addSample(Type
  * @return Filtered value.
  */
 template <typename TypeInput, typename TypeMid, uint8_t OLD_RATIO, uint8_t NEW_RATIO>
-TypeInput ExponentialFilter<TypeInput, TypeMid, OLD_RATIO, NEW_RATIO>::getFiltered() const
+TypeInput ExponentialFilter<TypeInput, TypeMid, OLD_RATIO, NEW_RATIO>::getFilteredImpl() const
 {
     return last_out;
-}
\ No newline at end of file
+}
+
+// === PreciseExponentialFilter ===
+
+/**
+ * @brief Constructor for PreciseExponentialFilter.
+ * Initializes the state to zero.
+ * @tparam TypeInput Type of the input samples.
+ * @tparam TypeState Type of the fixed point state.
+ * @tparam OLD_RATIO Weighting ratio for the old value.
+ * @tparam NEW_RATIO Weighting ratio for the new sample.
+ * @tparam FRACTION_BITS Bits of state below the input LSB.
+ */
+template <typename TypeInput, typename TypeState, uint8_t OLD_RATIO, uint8_t NEW_RATIO, uint8_t FRACTION_BITS>
+PreciseExponentialFilter<TypeInput, TypeState, OLD_RATIO, NEW_RATIO, FRACTION_BITS>::PreciseExponentialFilter() = default;
+
+/**
+ * @brief Adds a new sample to the PreciseExponentialFilter.
+ * Shift-only if OLD_RATIO + NEW_RATIO is a power of two, 64-bit multiply and divide otherwise.
+ * @tparam TypeInput Type of the input samples.
+ * @tparam TypeState Type of the fixed point state.
+ * @tparam OLD_RATIO Weighting ratio for the old value.
+ * @tparam NEW_RATIO Weighting ratio for the new sample.
+ * @tparam FRACTION_BITS Bits of state below the input LSB.
+ * @param sample New input sample to add.
+ */
+template <typename TypeInput, typename TypeState, uint8_t OLD_RATIO, uint8_t NEW_RATIO, uint8_t FRACTION_BITS>
+void PreciseExponentialFilter<TypeInput, TypeState, OLD_RATIO, NEW_RATIO, FRACTION_BITS>::addSampleImpl(TypeInput sample)
+{
+    if (POWER_OF_TWO)
+    {
+        // both terms are at most state and sample << FRACTION_BITS, so nothing can overflow
+        state = state - static_cast<TypeState>((state >> RATIO_SHIFT) * NEW_RATIO) + static_cast<TypeState>((static_cast<TypeState>(sample) << (FRACTION_BITS - RATIO_SHIFT)) * NEW_RATIO);
+        return;
+    }
+    const uint64_t target = static_cast<uint64_t>(sample) << FRACTION_BITS;
+    state = static_cast<TypeState>((static_cast<uint64_t>(state) * OLD_RATIO + target * NEW_RATIO + RATIO_SUM / 2) / RATIO_SUM);
+}
+
+/**
+ * @brief Retrieves the filtered value rounded to the nearest input LSB.
+ * @tparam TypeInput Type of the input samples.
+ * @tparam TypeState Type of the fixed point state.
+ * @tparam OLD_RATIO Weighting ratio for the old value.
+ * @tparam NEW_RATIO Weighting ratio for the new sample.
+ * @tparam FRACTION_BITS Bits of state below the input LSB.
+ * @return Filtered value.
+ */
+template <typename TypeInput, typename TypeState, uint8_t OLD_RATIO, uint8_t NEW_RATIO, uint8_t FRACTION_BITS>
+TypeInput PreciseExponentialFilter<TypeInput, TypeState, OLD_RATIO, NEW_RATIO, FRACTION_BITS>::getFilteredImpl() const
+{
+    // state never exceeds the largest sample << FRACTION_BITS, so adding half an LSB can't wrap
+    return static_cast<TypeInput>((state + (static_cast<TypeState>(1) << (FRACTION_BITS - 1))) >> FRACTION_BITS);
+}
+
+// === MedianFilter ===
+
+/**
+ * @brief Constructor for MedianFilter.
+ * The window is filled by the first sample.
+ * @tparam TypeInput Type of the input samples.
+ * @tparam SIZE Number of taps.
+ */
+template <typename TypeInput, uint8_t SIZE>
+MedianFilter<TypeInput, SIZE>::MedianFilter() = default;
+
+/**
+ * @brief Adds a new sample to the MedianFilter.
+ * Shifts the window, then takes the median of a copy with medianNetwork().
+ * @tparam TypeInput Type of the input samples.
+ * @tparam SIZE Number of taps.
+ * @param sample New input sample to add.
+ */
+template <typename TypeInput, uint8_t SIZE>
+void MedianFilter<TypeInput, SIZE>::addSampleImpl(TypeInput sample)
+{
+    if (!primed)
+    {
+        for (TypeInput &value : window)
+            value = sample;
+        primed = true;
+    }
+    for (uint8_t i = 0; i + 1 < SIZE; ++i)
+        window[i] = window[i + 1];
+    window[SIZE - 1] = sample;
+
+    TypeInput p[SIZE];
+    for (uint8_t i = 0; i < SIZE; ++i)
+        p[i] = window[i];
+    median = medianNetwork(p);
+}
+
+/**
+ * @brief Retrieves the median of the last SIZE samples.
+ * @tparam TypeInput Type of the input samples.
+ * @tparam SIZE Number of taps.
+ * @return Filtered value, 0 before the first sample.
+ */
+template <typename TypeInput, uint8_t SIZE>
+TypeInput MedianFilter<TypeInput, SIZE>::getFilteredImpl() const
+{
+    return median;
+}
+
+// === BiquadFilter ===
+
+/**
+ * @brief Constructor for BiquadFilter.
+ * Initializes the history to zero, as if the input had been 0 forever.
+ * @tparam TypeInput Type of the input samples.
+ * @tparam TypeCoeff Signed type of the coefficients.
+ * @tparam TypeAcc Signed type of the accumulator and states.
+ * @tparam FORM Filter structure.
+ * @param coeffs_ Filter coefficients, e.g. from biquadLowPass().
+ */
+template <typename TypeInput, typename TypeCoeff, typename TypeAcc, BiquadForm FORM>
+BiquadFilter<TypeInput, TypeCoeff, TypeAcc, FORM>::BiquadFilter(const BiquadCoefficients<TypeCoeff> &coeffs_)
+    : coeffs(coeffs_)
+{
+}
+
+/**
+ * @brief Adds a new sample to the BiquadFilter.
+ * @tparam TypeInput Type of the input samples.
+ * @tparam TypeCoeff Signed type of the coefficients.
+ * @tparam TypeAcc Signed type of the accumulator and states.
+ * @tparam FORM Filter structure.
+ * @param sample New input sample to add.
+ */
+template <typename TypeInput, typename TypeCoeff, typename TypeAcc, BiquadForm FORM>
+void BiquadFilter<TypeInput, TypeCoeff, TypeAcc, FORM>::addSampleImpl(TypeInput sample)
+{
+    const TypeAcc x = static_cast<TypeAcc>(sample);
+    const TypeAcc acc = (FORM == BiquadForm::DirectForm1)
+                            ? error + x * coeffs.b0 + z[0] * coeffs.b1 + z[1] * coeffs.b2 - z[2] * coeffs.a1 - z[3] * coeffs.a2
+                            : error + x * coeffs.b0 + z[0];
+    const TypeAcc y = acc >> FRACTION_BITS; // floor, the remainder goes into error
+    const TypeAcc y_sat = saturate(y);
+    error = (y == y_sat) ? acc - y * (static_cast<TypeAcc>(1) << FRACTION_BITS) : 0;
+    if (FORM == BiquadForm::DirectForm1)
+    {
+        z[1] = z[0];
+        z[0] = x;
+        z[3] = z[2];
+        z[2] = y_sat;
+    }
+    else
+    {
+        z[0] = x * coeffs.b1 - y_sat * coeffs.a1 + z[1];
+        z[1] = x * coeffs.b2 - y_sat * coeffs.a2;
+    }
+    out = static_cast<TypeInput>(y_sat);
+}
+
+/**
+ * @brief Retrieves the filtered value from the BiquadFilter.
+ * @tparam TypeInput Type of the input samples.
+ * @tparam TypeCoeff Signed type of the coefficients.
+ * @tparam TypeAcc Signed type of the accumulator and states.
+ * @tparam FORM Filter structure.
+ * @return Filtered value.
+ */
+template <typename TypeInput, typename TypeCoeff, typename TypeAcc, BiquadForm FORM>
+TypeInput BiquadFilter<TypeInput, TypeCoeff, TypeAcc, FORM>::getFilteredImpl() const
+{
+    return out;
+}
+
+// === FilterChain ===
+
+/**
+ * @brief Adds a new sample to the first stage, and its output to the rest of the chain.
+ * @tparam First The first stage.
+ * @tparam Rest The following stages.
+ * @param sample New input sample to add.
+ */
+template <typename First, typename... Rest>
+void FilterChain<First, Rest...>::addSampleImpl(typename First::Input sample)
+{
+    head.addSample(sample);
+    tail.addSample(head.getFiltered());
+}
+
+/**
+ * @brief Retrieves the filtered value of the last stage.
+ * @tparam First The first stage.
+ * @tparam Rest The following stages.
+ * @return Filtered value.
+ */
+template <typename First, typename... Rest>
+typename FilterChain<Rest...>::Output FilterChain<First, Rest...>::getFilteredImpl() const
+{
+    return tail.getFiltered();
+}
+
+// === FilterBank ===
+
+/**
+ * @brief Constructor for FilterBank.
+ * Initializes every state to zero, the windows are filled by the first samples.
+ * @tparam TAPS Taps of the median stage.
+ * @tparam SHIFTS Exponential average shift of each channel.
+ */
+template <uint8_t TAPS, uint8_t... SHIFTS>
+FilterBank<TAPS, SHIFTS...>::FilterBank() = default;
+
+/**
+ * @brief Adds one sample to every channel, unrolled over the channels at compile time.
+ * @tparam TAPS Taps of the median stage.
+ * @tparam SHIFTS Exponential average shift of each channel.
+ * @param samples One sample per channel, in channel order.
+ */
+template <uint8_t TAPS, uint8_t... SHIFTS>
+void FilterBank<TAPS, SHIFTS...>::addSamples(const uint16_t (&samples)[CHANNELS])
+{
+    if (!primed)
+    {
+        for (uint8_t tap = 0; tap < TAPS; ++tap)
+            for (uint8_t channel = 0; channel < CHANNELS; ++channel)
+                window[tap][channel] = samples[channel];
+        primed = true;
+    }
+    updateChannels<0, SHIFTS...>(samples);
+}
+
+/**
+ * @brief Updates channel CHANNEL, then the following channels.
+ * Median of the shifted window, then state += (median - state) / 2^SHIFT done as in PreciseExponentialFilter.
+ * @tparam TAPS Taps of the median stage.
+ * @tparam SHIFTS Exponential average shift of each channel.
+ * @tparam CHANNEL Channel to update.
+ * @tparam SHIFT Exponential average shift of CHANNEL.
+ * @tparam REST Exponential average shifts of the following channels.
+ * @param samples One sample per channel, in channel order.
+ */
+template <uint8_t TAPS, uint8_t... SHIFTS>
+template <uint8_t CHANNEL, uint8_t SHIFT, uint8_t... REST>
+void FilterBank<TAPS, SHIFTS...>::updateChannels(const uint16_t (&samples)[CHANNELS])
+{
+    static_assert(SHIFT <= FRACTION_BITS, "FilterBank shifts must be at most FRACTION_BITS");
+    uint16_t p[TAPS];
+    for (uint8_t tap = 0; tap + 1 < TAPS; ++tap)
+    {
+        window[tap][CHANNEL] = window[tap + 1][CHANNEL];
+        p[tap] = window[tap][CHANNEL];
+    }
+    window[TAPS - 1][CHANNEL] = samples[CHANNEL];
+    p[TAPS - 1] = samples[CHANNEL];
+    median[CHANNEL] = medianNetwork(p);
+
+    state[CHANNEL] = state[CHANNEL] - (state[CHANNEL] >> SHIFT) + (static_cast<uint32_t>(median[CHANNEL]) << (FRACTION_BITS - SHIFT));
+    updateChannels<CHANNEL + 1, REST...>(samples);
+}
+
+/**
+ * @brief End of the channel recursion.
+ * @tparam TAPS Taps of the median stage.
+ * @tparam SHIFTS Exponential average shift of each channel.
+ * @tparam CHANNEL One past the last channel.
+ */
+template <uint8_t TAPS, uint8_t... SHIFTS>
+template <uint8_t CHANNEL>
+void FilterBank<TAPS, SHIFTS...>::updateChannels(const uint16_t (&)[CHANNELS])
+{
+}
+
+/**
+ * @brief Retrieves the filtered value of a channel, rounded to the nearest input LSB.
+ * @tparam TAPS Taps of the median stage.
+ * @tparam SHIFTS Exponential average shift of each channel.
+ * @param channel Channel index.
+ * @return Filtered value.
+ */
+template <uint8_t TAPS, uint8_t... SHIFTS>
+uint16_t FilterBank<TAPS, SHIFTS...>::getFiltered(const uint8_t channel) const
+{
+    return static_cast<uint16_t>((state[channel] + (static_cast<uint32_t>(1) << (FRACTION_BITS - 1))) >> FRACTION_BITS);
+}
+
+/**
+ * @brief Copies every filtered value at once.
+ * @tparam TAPS Taps of the median stage.
+ * @tparam SHIFTS Exponential average shift of each channel.
+ * @param out One filtered value per channel, in channel order.
+ */
+template <uint8_t TAPS, uint8_t... SHIFTS>
+void FilterBank<TAPS, SHIFTS...>::snapshot(uint16_t (&out)[CHANNELS]) const
+{
+    for (uint8_t channel = 0; channel < CHANNELS; ++channel)
+        out[channel] = getFiltered(channel);
+}
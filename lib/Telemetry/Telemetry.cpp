@@ -2,8 +2,8 @@
  * @file Telemetry.cpp
  * @author Planeson, Red Bird Racing
  * @brief Implementation of the Telemetry class for sending telemetry data over CAN bus
- * @version 1.0
- * @date 2026-01-26
+ * @version 1.3
+ * @date 2026-10-16
  * @see Telemetry.hpp
  */
 
@@ -11,11 +11,11 @@
 
 /**
  * @brief Construct a new Telemetry object
- * @param mcp2515_ Reference to MCP2515 for sending CAN messages
+ * @param can_tx_ Reference to the TX queue of the MCP2515 for sending CAN messages, a frame still waiting is replaced by the next one
  * @param car_ Reference to CarState
  */
-Telemetry::Telemetry(MCP2515 &mcp2515_, CarState &car_)
-    : mcp2515(mcp2515_), car(car_)
+Telemetry::Telemetry(CanTxQueue &can_tx_, CarState &car_)
+    : can_tx(can_tx_), car(car_)
 {
 }
 
@@ -25,7 +25,7 @@ Telemetry::Telemetry(MCP2515 &mcp2515_, CarState &car_)
 void Telemetry::sendPedal()
 {
     can_frame pedal_frame = car.pedal.toCanFrame();
-    mcp2515.sendMessage(&pedal_frame);
+    can_tx.send(pedal_frame);
 }
 
 /**
@@ -34,7 +34,7 @@ void Telemetry::sendPedal()
 void Telemetry::sendMotor()
 {
     can_frame motor_frame = car.motor.toCanFrame();
-    mcp2515.sendMessage(&motor_frame);
+    can_tx.send(motor_frame);
 }
 
 /**
@@ -43,5 +43,32 @@ void Telemetry::sendMotor()
 void Telemetry::sendBms()
 {
     can_frame bms_frame = car.bms.toCanFrame();
-    mcp2515.sendMessage(&bms_frame);
+    can_tx.send(bms_frame);
+}
+
+/**
+ * @brief Internal helper to get and send the CAN controller telemetry frame
+ */
+void Telemetry::sendCan()
+{
+    can_frame can_telem_frame = car.can.toCanFrame();
+    can_tx.send(can_telem_frame);
+}
+
+/**
+ * @brief Internal helper to get and send the CAN transmit queue telemetry frame
+ */
+void Telemetry::sendCanTx()
+{
+    can_frame can_tx_frame = car.can_tx.toCanFrame();
+    can_tx.send(can_tx_frame);
+}
+
+/**
+ * @brief Internal helper to get and send the scheduler load shedding telemetry frame
+ */
+void Telemetry::sendScheduler()
+{
+    can_frame scheduler_frame = car.scheduler.toCanFrame();
+    can_tx.send(scheduler_frame);
 }
\ No newline at end of file
@@ -2,8 +2,8 @@
  * @file main.cpp
  * @author Planeson, Chiho, Red Bird Racing
  * @brief Main VCU program entry point
- * @version 2.2.1
- * @date 2026-02-25
+ * @version 2.18.0
+ * @date 2026-10-16
  * @dir include @brief Contains all header-only files.
  * @dir lib @brief Contains all the libraries. Each library is in its own folder of the same name.
  * @dir src @brief Contains the main.cpp file, the main file of the program.
@@ -16,8 +16,17 @@
 #include "Enums.hpp"
 #include "CarState.hpp"
 #include "Scheduler.hpp"
+#include "StaticScheduler.hpp"
 #include "Curves.hpp"
 #include "Telemetry.hpp"
+#include "Calibration.hpp"
+#include "Command.hpp"
+#include "AdcSequencer.hpp"
+#include "FastPin.hpp"
+#include "HallSensor.hpp"
+#include "CanInterrupt.hpp"
+#include "CanRx.hpp"
+#include "CanTx.hpp"
 #include "Debug.hpp"
 
 // ignore -Wpedantic warnings for mcp2515.h
@@ -38,16 +47,65 @@ constexpr uint8_t INPUT_COUNT = 5;
 constexpr uint8_t OUTPUT_COUNT = 3;
 constexpr uint8_t pins_in[INPUT_COUNT] = {DRIVE_MODE_BTN, BRAKE_IN, APPS_5V, APPS_3V3, HALL_SENSOR};
 constexpr uint8_t pins_out[OUTPUT_COUNT] = {FRG, BRAKE_LIGHT, BUZZER};
+constexpr uint8_t adc_pins[PEDAL_INPUT_COUNT] = {APPS_5V, APPS_3V3, BRAKE_IN}; // in PedalInput order, HALL_SENSOR is timed by HallSensor
+constexpr uint8_t adc_oversample_bits[PEDAL_INPUT_COUNT] = {ADC_OVERSAMPLE_BITS, ADC_OVERSAMPLE_BITS, ADC_OVERSAMPLE_BITS};
+
+// pins accessed in loop(), direct port access instead of digitalRead/digitalWrite, modes set by pinMode in setup()
+using BrakeLightPin = FastPin<BRAKE_LIGHT>;
+using BuzzerPin = FastPin<BUZZER>;
+using FrgPin = FastPin<FRG>;
+using DriveModeBtnPin = FastPin<DRIVE_MODE_BTN>;
+constexpr bool DRIVE_MODE_BTN_LEVEL = (BUTTON_ACTIVE == HIGH); /**< DriveModeBtnPin::read() when pressed */
 
 // === even if unused, initialize ALL mcp2515 to make sure the CS pin is set up and they don't interfere with the SPI bus ===
 MCP2515 mcp2515_motor(CS_CAN_MOTOR); // motor CAN
 MCP2515 mcp2515_BMS(CS_CAN_BMS);     // BMS CAN
 MCP2515 mcp2515_DL(CS_CAN_DL);       // datalogger CAN
 
+// TX queue of each MCP2515, one per chip: those no bus ends up using are dropped by the linker
+CanTxQueue tx_mcp2515_motor(mcp2515_motor);
+CanTxQueue tx_mcp2515_BMS(mcp2515_BMS);
+CanTxQueue tx_mcp2515_DL(mcp2515_DL);
+
+// INT line of each MCP2515, CAN_INT_NONE without INT_CAN_* in BoardConfig.h: RX is then polled every tick
+using int_mcp2515_motor = CanIntPin<INT_CAN_MOTOR>;
+using int_mcp2515_BMS = CanIntPin<INT_CAN_BMS>;
+using int_mcp2515_DL = CanIntPin<INT_CAN_DL>;
+
 #define mcp2515_motor mcp2515_DL
 #define mcp2515_BMS mcp2515_DL
 // #define mcp2515_DL mcp2515_motor
 
+// TX queue of the MCP2515 behind a bus, following the #defines above, so buses sharing an MCP2515 share its queue
+#define CAN_TX_QUEUE_OF(mcp) tx_##mcp
+#define CAN_TX_QUEUE(mcp) CAN_TX_QUEUE_OF(mcp)
+CanTxQueue &can_tx_motor = CAN_TX_QUEUE(mcp2515_motor);
+CanTxQueue &can_tx_BMS = CAN_TX_QUEUE(mcp2515_BMS);
+CanTxQueue &can_tx_DL = CAN_TX_QUEUE(mcp2515_DL);
+
+// INT line of the MCP2515 behind a bus, following the #defines above like the TX queues
+#define CAN_INT_OF(mcp) int_##mcp
+#define CAN_INT(mcp) CAN_INT_OF(mcp)
+using MotorCanInt = CAN_INT(mcp2515_motor);
+using BmsCanInt = CAN_INT(mcp2515_BMS);
+using DlCanInt = CAN_INT(mcp2515_DL);
+#ifdef mcp2515_motor
+constexpr bool MOTOR_RX_IN_LOOP = false; // shared MCP2515: reading it as frames arrive would take the frames of the other buses
+#else
+constexpr bool MOTOR_RX_IN_LOOP = MotorCanInt::WIRED; // read the motor bus as soon as a frame arrives, not at the next tick
+#endif
+// RXB1 of the datalogger MCP2515 holds the commands, a bus sharing it only empties RXB0, follow the #defines above
+#if defined(mcp2515_motor) || defined(mcp2515_DL)
+constexpr uint8_t MOTOR_RX_BUFFERS = MCP2515::CANINTF_RX0IF;
+#else
+constexpr uint8_t MOTOR_RX_BUFFERS = CAN_RX_ALL_BUFFERS;
+#endif
+#ifdef mcp2515_BMS
+constexpr uint8_t BMS_RX_BUFFERS = MCP2515::CANINTF_RX0IF;
+#else
+constexpr uint8_t BMS_RX_BUFFERS = CAN_RX_ALL_BUFFERS;
+#endif
+
 constexpr uint8_t NUM_MCP = 3;
 MCP2515 MCPS[NUM_MCP] = {mcp2515_motor, mcp2515_BMS, mcp2515_DL};
 
@@ -55,8 +113,11 @@ constexpr uint16_t BUSSIN_MILLIS = 2000;       // The amount of time that the bu
 constexpr uint16_t BMS_OVERRIDE_MILLIS = 1000; // The maximum amount of time to wait for the BMS to start HV, if passed, assume started but not reading response
 
 constexpr uint16_t BRAKE_THRESHOLD = BRAKE_TABLE[0].in; // The threshold for the brake pedal to be considered pressed
+constexpr uint16_t PROFILE_BTN_DEBOUNCE_MILLIS = 200;   // Minimum time between two presses of the drive mode button that cycle the torque profile
 
-bool brake_pressed = false; // boolean for brake light on VCU (for ignition)
+bool brake_pressed = false;    // boolean for brake light on VCU (for ignition)
+bool drive_btn_last = false;   // drive mode button state of the previous loop, for edge detection
+uint32_t drive_btn_millis = 0; // time of the last drive mode button press, for debouncing
 
 /**
  * @brief Global car state structure.
@@ -66,18 +127,50 @@ struct CarState car = {
     {}, // TelemetryPedal
     {}, // TelemetryMotor
     {}, // TelemetryBms
+    {}, // TelemetryCan
+    {}, // TelemetryCanTx
+    {}, // TelemetryScheduler
     0,  // millis
     0   // status_millis
 };
 
 // Global objects
-Pedal pedal(mcp2515_motor, car, car.pedal.apps_5v);
-BMS bms(mcp2515_BMS, car);
-Telemetry telem(mcp2515_DL, car);
+AdcSequencer adc(adc_pins, adc_oversample_bits);
+HallSensor hall;
+Pedal pedal(mcp2515_motor, can_tx_motor, car, car.pedal.apps_5v);
+BMS bms(mcp2515_BMS, can_tx_BMS, car);
+Telemetry telem(can_tx_DL, car);
+Calibration calibration(pedal, car);
+
+/**
+ * @brief Passes a frame that rolled over into RXB1 of the datalogger MCP2515 to the buses sharing it, which only empty RXB0.
+ * @param rx_frame Frame read by Command that isn't a command.
+ */
+void commandRollover(const can_frame &rx_frame)
+{
+#if defined(mcp2515_motor) || defined(mcp2515_DL)
+    pedal.readMotorFrame(rx_frame);
+#endif
+#ifdef mcp2515_BMS
+    bms.readFrame(rx_frame);
+#endif
+    (void)rx_frame; // unused if no bus shares the datalogger MCP2515
+}
+Command command(mcp2515_DL, can_tx_DL, car, pedal, calibration, commandRollover);
+
+/**
+ * @brief Reads the motor bus if its MCP2515 has received a frame, the motor timeout is checked either way.
+ */
+void serviceMotorRx()
+{
+    const bool pending = MotorCanInt::pending();
+    if (!pedal.readMotor(pending, MOTOR_RX_BUFFERS) && pending)
+        MotorCanInt::release(mcp2515_motor); // INT held low by an error flag
+}
 
 void schedulerMotorRead()
 {
-    pedal.readMotor();
+    serviceMotorRx();
 }
 void schedulerPedalSend()
 {
@@ -85,10 +178,13 @@ void schedulerPedalSend()
 }
 void scheduler_bms()
 {
-    bms.checkHv();
+    const bool pending = BmsCanInt::pending();
+    if (!bms.checkHv(pending, BMS_RX_BUFFERS) && pending)
+        BmsCanInt::release(mcp2515_BMS);
 }
 void schedulerTelemetryPedal()
 {
+    car.pedal.wheel_rpm = hall.update(micros());
     telem.sendPedal();
 }
 void schedulerTelemetryMotor()
@@ -99,12 +195,72 @@ void schedulerTelemetryBms()
 {
     telem.sendBms();
 }
-
-Scheduler<3, NUM_MCP> scheduler(
-    10000,  // period_us
-    500,    // spin_threshold_us
-    *micros // current_time_us function pointer
-);
+void schedulerTelemetryCan()
+{
+    car.can_tx.tx_dropped[static_cast<uint8_t>(McpIndex::Motor)] = can_tx_motor.getDropped();
+    car.can_tx.tx_dropped[static_cast<uint8_t>(McpIndex::Bms)] = can_tx_BMS.getDropped();
+    car.can_tx.tx_dropped[static_cast<uint8_t>(McpIndex::Datalogger)] = can_tx_DL.getDropped();
+    // a queue shared by buses is only counted once
+    uint32_t coalesced = can_tx_motor.getCoalesced();
+    if (&can_tx_BMS != &can_tx_motor)
+        coalesced += can_tx_BMS.getCoalesced();
+    if (&can_tx_DL != &can_tx_motor && &can_tx_DL != &can_tx_BMS)
+        coalesced += can_tx_DL.getCoalesced();
+    car.can_tx.tx_coalesced = coalesced > UINT16_MAX ? UINT16_MAX : static_cast<uint16_t>(coalesced);
+    telem.sendCan();
+    telem.sendCanTx();
+}
+void schedulerCanTx()
+{
+    can_tx_motor.flush(); // the torque command first
+    if (&can_tx_BMS != &can_tx_motor)
+        can_tx_BMS.flush();
+    if (&can_tx_DL != &can_tx_motor && &can_tx_DL != &can_tx_BMS)
+        can_tx_DL.flush();
+}
+void schedulerCommandRead()
+{
+    if (DlCanInt::pending())
+        command.read();
+}
+void schedulerTelemetryScheduler(); // sends the scheduler's own load and timing, defined after it
+
+// task table: critical tasks first, then the rest, each in table order, interleaved across the MCP2515s like the round-robin of Scheduler
+// telemetry is shed first when a tick runs over SCHEDULER_BUDGET_US, the torque command never is
+// ticks from Timer1, sleeping between interrupts; pass nullptr instead of sleepIdle to give the idle time to loop()
+StaticScheduler<
+    TimerClock,
+    CriticalTask<schedulerCanTx, McpIndex::Motor>, // frames left waiting by the previous tick, torque first, before this tick queues more
+    CriticalTask<schedulerMotorRead, McpIndex::Motor>,
+    StaticTask<scheduler_bms, McpIndex::Bms, 5, true>, // only while waiting for HV ready in STARTIN
+    LowPriorityTask<schedulerTelemetryPedal, McpIndex::Datalogger>,
+    CriticalTask<schedulerPedalSend, McpIndex::Motor>,
+    LowPriorityTask<schedulerTelemetryMotor, McpIndex::Datalogger>,
+    LowPriorityTask<schedulerTelemetryBms, McpIndex::Datalogger, 10>,
+    LowPriorityTask<schedulerTelemetryCan, McpIndex::Datalogger, 10>,
+    StaticTask<schedulerCommandRead, McpIndex::Datalogger, 1>,
+    LowPriorityTask<schedulerTelemetryScheduler, McpIndex::Datalogger, 10>>
+    scheduler(
+        TimerClock(
+            SCHEDULER_PERIOD_US,  // period_us
+            TimerClock::sleepIdle // idle_fn
+            ),
+        SCHEDULER_BUDGET_US // budget_us
+    );
+
+void schedulerTelemetryScheduler()
+{
+    car.scheduler.deferred = scheduler.getDeferred();
+    car.scheduler.dropped = scheduler.getDropped();
+    telem.sendScheduler();
+#if SCHEDULER_STATS
+    can_frame stats_frame;
+    stats_frame.can_id = TELEMETRY_SCHEDULER_MSG;
+    stats_frame.can_dlc = SCHEDULER_STATS_FRAME_BYTES;
+    scheduler.statsFrame(stats_frame.data);
+    can_tx_DL.send(stats_frame);
+#endif
+}
 
 /**
  * @brief Setup function for initializing the VCU system.
@@ -131,6 +287,10 @@ void setup()
     }
     DBGLN_GENERAL("GPIO pins initialized");
 
+    // analog inputs are converted in the background from here on, analogRead must not be used
+    adc.begin();
+    hall.begin(); // wheel speed from the hall sensor edges, pin change interrupt
+
     // Initialize MCP2515 CAN controllers
     DBGLN_GENERAL("Initializing CAN interfaces...");
     for (uint8_t i = 0; i < NUM_MCP; ++i)
@@ -140,30 +300,33 @@ void setup()
         MCPS[i].setNormalMode();
     }
 
-    // Initialize MCP2515 filters for Pedal and BMS
+    // Initialize MCP2515 filters for Pedal, BMS and Command
     pedal.initFilter();
     bms.initFilter();
+    command.initFilter();
 
     while (!pedal.initMotor())
     {
         delay(20);
     }
 
+    CanInterrupt::begin(); // wake up on received frames, if the INT lines are wired
     DBGLN_GENERAL("CAN interfaces initialized");
 
 #if DEBUG_CAN
     DBGLN_GENERAL("Initializing Debug CAN...");
-    Debug_CAN::initialize(&mcp2515_DL); // Currently using datalogger CAN for debug messages
+    Debug_CAN::initialize(&can_tx_DL); // Currently using datalogger CAN for debug messages
     DBGLN_GENERAL("Debug CAN initialized");
 #endif
 
-    DBGLN_GENERAL("Adding scheduler tasks...");
-    scheduler.addTask(McpIndex::Motor, schedulerMotorRead, 1);
-    scheduler.addTask(McpIndex::Motor, schedulerPedalSend, 1);
-    scheduler.addTask(McpIndex::Datalogger, schedulerTelemetryPedal, 1);
-    scheduler.addTask(McpIndex::Datalogger, schedulerTelemetryMotor, 1);
-    scheduler.addTask(McpIndex::Datalogger, schedulerTelemetryBms, 10);
-    DBGLN_GENERAL("Scheduler tasks added");
+    // Use the maps saved over the calibration channel if any, swapped in on the first tick
+    if (calibration.load() == CalibrationResult::Ok)
+    {
+        DBGLN_GENERAL("Calibrated pedal maps loaded from EEPROM");
+    }
+
+    // first tick one period from here
+    scheduler.begin();
 
     DBGLN_GENERAL("===== SETUP COMPLETE =====");
 }
@@ -174,21 +337,29 @@ void setup()
  */
 void loop()
 {
-    // DBG_HALL_SENSOR(analogRead(HALL_SENSOR));
+    // DBG_HALL_SENSOR(car.pedal.wheel_rpm);
     car.millis = millis();
-    pedal.update(analogRead(APPS_5V), analogRead(APPS_3V3), analogRead(BRAKE_IN));
+    if (adc.newRound()) // filters run once per ADC round, whatever the loop rate
+    {
+        pedal.update(adc.read(static_cast<uint8_t>(PedalInput::Apps5v)),
+                     adc.read(static_cast<uint8_t>(PedalInput::Apps3v3)),
+                     adc.read(static_cast<uint8_t>(PedalInput::Brake)));
+    }
 
     brake_pressed = (car.pedal.brake >= BRAKE_THRESHOLD);
-    digitalWrite(BRAKE_LIGHT, brake_pressed ? HIGH : LOW);
+    BrakeLightPin::write(brake_pressed);
+    const bool drive_btn_pressed = (DriveModeBtnPin::read() == DRIVE_MODE_BTN_LEVEL);
+    const bool drive_btn_edge = drive_btn_pressed && !drive_btn_last;
+    drive_btn_last = drive_btn_pressed;
     scheduler.update();
-
-    car.pedal.hall_sensor = analogRead(HALL_SENSOR);
+    if (MOTOR_RX_IN_LOOP && MotorCanInt::pending())
+        serviceMotorRx(); // fresh motor_rpm for the next torque command
 
     if (car.pedal.status.bits.force_stop)
     {
         car.pedal.status.bits.car_status = CarStatus::Init; // safety, later change to fault status
-        digitalWrite(BUZZER, LOW);                          // Turn off buzzer
-        digitalWrite(FRG, LOW);                             // Turn off drive mode LED
+        BuzzerPin::write(false);                            // Turn off buzzer
+        FrgPin::write(false);                               // Turn off drive mode LED
         return;                                             // If fault force stop is active, do not proceed with the rest of the loop
         // pedal is still being updated, data can still be gathered and sent through CAN/serial
     }
@@ -201,37 +372,45 @@ void loop()
 
     // do not return here if not in DRIVE mode, else can't detect pedal being on while starting
     case CarStatus::Init:
-        if (digitalRead(DRIVE_MODE_BTN) == BUTTON_ACTIVE && brake_pressed)
+        if (drive_btn_pressed && brake_pressed)
         {
             car.pedal.status.bits.car_status = CarStatus::Startin;
             car.status_millis = car.millis;
 
-            scheduler.addTask(McpIndex::Bms, scheduler_bms, 5); // check for HV ready in STARTIN
+            scheduler.enable<scheduler_bms>(); // check for HV ready in STARTIN
+        }
+        else if (drive_btn_edge && car.millis - drive_btn_millis >= PROFILE_BTN_DEBOUNCE_MILLIS)
+        {
+            // button without brake cycles the torque profile, Pedal swaps it in on the next tick
+            drive_btn_millis = car.millis;
+            // cycle from the pending selection, so presses before the swap aren't lost, and Calibrated wraps to the first profile
+            const uint8_t next_profile = static_cast<uint8_t>(pedal.getPendingProfile()) + 1;
+            pedal.selectProfile(static_cast<TorqueProfileId>(next_profile < TORQUE_PROFILE_COUNT ? next_profile : 0));
         }
         break;
 
     case CarStatus::Startin:
-        if (digitalRead(DRIVE_MODE_BTN) != BUTTON_ACTIVE || !brake_pressed)
+        if (!drive_btn_pressed || !brake_pressed)
         {
             car.pedal.status.bits.car_status = CarStatus::Init;
             car.status_millis = car.millis;
-            scheduler.removeTask(McpIndex::Bms, scheduler_bms); // stop checking BMS HV ready since return to INIT
+            scheduler.disable<scheduler_bms>(); // stop checking BMS HV ready since return to INIT
             break;
         }
         if (car.pedal.status.bits.hv_ready)
         {
             car.pedal.status.bits.car_status = CarStatus::Bussin;
             car.status_millis = car.millis;
-            digitalWrite(BUZZER, HIGH);
-            scheduler.removeTask(McpIndex::Bms, scheduler_bms); // stop checking BMS HV ready since is already ready
+            BuzzerPin::high();
+            scheduler.disable<scheduler_bms>(); // stop checking BMS HV ready since is already ready
             break;
         }
         if (car.millis - car.status_millis >= BMS_OVERRIDE_MILLIS)
         {
             car.pedal.status.bits.car_status = CarStatus::Bussin;
             car.status_millis = car.millis;
-            digitalWrite(BUZZER, HIGH);
-            scheduler.removeTask(McpIndex::Bms, scheduler_bms); // stop checking BMS HV ready since override to BUSSIN
+            BuzzerPin::high();
+            scheduler.disable<scheduler_bms>(); // stop checking BMS HV ready since override to BUSSIN
             break;
         }
         break;
@@ -239,8 +418,8 @@ void loop()
     case CarStatus::Bussin:
         if (car.millis - car.status_millis >= BUSSIN_MILLIS)
         {
-            digitalWrite(BUZZER, LOW);
-            digitalWrite(FRG, HIGH);
+            BuzzerPin::low();
+            FrgPin::high();
             car.pedal.status.bits.car_status = CarStatus::Drive;
         }
         break;
@@ -0,0 +1,459 @@
+/**
+ * @file test_benchmark.cpp
+ * @author Planeson, Red Bird Racing
+ * @brief On-target cycle-count benchmarks for hot path helpers, run with `pio test -e ATmega328P -f test_benchmark`
+ * @details Timer1 runs at prescaler 1, so TCNT1 counts CPU cycles directly.
+ * Each benchmark reports worst and mean cycles per call with the measurement overhead removed,
+ * calls must stay below 65535 cycles to fit in TCNT1.
+ * @version 1.11
+ * @date 2026-10-16
+ * @see Interp.hpp, SignalProcessing.hpp, AdcSequencer.hpp, FastPin.hpp, HallSensor.hpp, Scheduler.hpp, StaticScheduler.hpp
+ */
+#include <Arduino.h>
+#include <unity.h>
+#include <stdio.h>
+#include "Interp.hpp"
+#include "Curves.hpp"
+#include "SignalProcessing.hpp"
+#include "AdcSequencer.hpp"
+#include "FastPin.hpp"
+#include "HallSensor.hpp"
+#include "Scheduler.hpp"
+#include "StaticScheduler.hpp"
+#include "BoardConfig.h"
+
+constexpr uint16_t ADC_SIZE = ADC_MAX + 1; /**< Number of ADC values at ADC_BITS */
+
+// same template arguments as the maps in Pedal.hpp
+constexpr LinearInterp<uint16_t, int16_t, int32_t, 5> THROTTLE_MAP{THROTTLE_TABLE};
+constexpr FixedSlopeInterp<uint16_t, int16_t, int32_t, 5> THROTTLE_FIXED_MAP{THROTTLE_TABLE};
+constexpr FlashLut<int16_t, 1024, ADC_OVERSAMPLE_BITS> THROTTLE_LUT PROGMEM{THROTTLE_MAP};
+constexpr LinearInterp<uint16_t, int16_t, int32_t, 5> BRAKE_MAP{BRAKE_TABLE};
+
+/** 30-point non-uniform table, for segment lookup cost against the 5-point tables */
+constexpr TablePoint<uint16_t, int16_t> FINE_TABLE[30] = {
+    {120, 0}, {122, -100}, {125, -300}, {129, -700}, {134, -1300}, {140, -2100}, {147, -3100}, {155, -4300}, {164, -5700}, {174, -7300},
+    {185, -9100}, {197, -11000}, {210, -13000}, {224, -15000}, {239, -17000}, {255, -19000}, {272, -21000}, {290, -22900}, {309, -24700}, {329, -26400},
+    {350, -27900}, {372, -29200}, {395, -30300}, {419, -31100}, {444, -31700}, {470, -32100}, {497, -32300}, {525, -32400}, {554, -32450}, {584, -32500}};
+constexpr LinearInterp<uint16_t, int16_t, int32_t, 30> FINE_MAP{FINE_TABLE};
+constexpr FixedSlopeInterp<uint16_t, int16_t, int32_t, 30> FINE_FIXED_MAP{FINE_TABLE};
+
+constexpr BilinearInterp<uint16_t, int16_t, int16_t, int32_t, 5, 3> THROTTLE_RPM_MAP{THROTTLE_APPS_AXIS, THROTTLE_RPM_AXIS};
+constexpr BilinearInterp<uint16_t, int16_t, int16_t, int32_t, 5, 3> REGEN_RPM_MAP{REGEN_BRAKE_AXIS, REGEN_RPM_AXIS};
+
+TorqueProfile active_profile = ENDURANCE_PROFILE; /**< RAM copy like Pedal's active profile, read through a pointer below */
+TorqueProfile *volatile active_profile_ptr = &active_profile;
+
+constexpr uint32_t TICK_BUDGET_CYCLES = F_CPU / 100; /**< CPU cycles in one 10ms scheduler tick */
+
+volatile int16_t sink_i16; /**< Results are written here so the calls aren't optimized away */
+
+/**
+ * @brief Cycle statistics of one benchmark
+ */
+struct CycleStats
+{
+    uint16_t worst; /**< Worst cycles of a single call */
+    uint32_t total; /**< Sum of cycles over all calls */
+    uint16_t calls; /**< Number of calls */
+};
+
+/**
+ * @brief Runs fn(i) for every i in [from, to) with interrupts off and records its cycle count
+ * @param fn Callable taking a uint16_t, must write its result to a volatile sink
+ * @param from First input
+ * @param to One past the last input
+ * @return Raw cycle statistics, including measurement overhead
+ */
+template <typename Fn>
+CycleStats measureCycles(Fn fn, const uint16_t from, const uint16_t to)
+{
+    CycleStats stats = {0, 0, 0};
+    for (uint16_t i = from; i < to; ++i)
+    {
+        noInterrupts();
+        TCNT1 = 0;
+        fn(i);
+        const uint16_t cycles = TCNT1;
+        interrupts();
+        if (cycles > stats.worst)
+            stats.worst = cycles;
+        stats.total += cycles;
+        ++stats.calls;
+    }
+    return stats;
+}
+
+uint16_t overhead_cycles = 0; /**< Cycles of an empty measurement, subtracted from every result */
+
+/**
+ * @brief Measures fn over [from, to) and prints worst and mean cycles per call
+ * @param name Name printed with the result
+ * @param fn Callable taking a uint16_t, must write its result to a volatile sink
+ * @param from First input
+ * @param to One past the last input
+ * @return Worst cycles of a single call, overhead removed
+ */
+template <typename Fn>
+uint16_t reportCycles(const char *name, Fn fn, const uint16_t from = 0, const uint16_t to = ADC_SIZE)
+{
+    const CycleStats stats = measureCycles(fn, from, to);
+    const uint16_t worst = stats.worst - overhead_cycles;
+    const uint16_t mean = stats.total / stats.calls - overhead_cycles;
+    char msg[80];
+    snprintf(msg, sizeof(msg), "%s: worst %u, mean %u cycles", name, worst, mean);
+    TEST_MESSAGE(msg);
+    return worst;
+}
+
+void setUp(void)
+{
+    // runs before each test
+    // optional in the sense that this can be empty
+    // to ensure it compiles on all platforms, do not remove this empty function
+}
+
+void tearDown(void)
+{
+    // runs after each test
+    // optional in the sense that this can be empty
+    // to ensure it compiles on all platforms, do not remove this empty function
+}
+
+void test_bench_throttle_map(void)
+{
+    const uint16_t divide = reportCycles("LinearInterp", [](uint16_t i)
+                                         { sink_i16 = THROTTLE_MAP.interp(i); });
+    const uint16_t fixed = reportCycles("FixedSlopeInterp", [](uint16_t i)
+                                        { sink_i16 = THROTTLE_FIXED_MAP.interp(i); });
+    const uint16_t lut = reportCycles("FlashLut", [](uint16_t i)
+                                      { sink_i16 = THROTTLE_LUT.lookup(i); });
+    TEST_ASSERT_LESS_THAN(divide, fixed);
+    TEST_ASSERT_LESS_THAN(fixed, lut);
+}
+
+void test_bench_segment_lookup(void)
+{
+    // inside the tables only, so every call does a segment lookup
+    reportCycles("LinearInterp 5 uniform", [](uint16_t i)
+                 { sink_i16 = BRAKE_MAP.interp(i); },
+                 BRAKE_TABLE[0].in + 1, BRAKE_TABLE[4].in);
+    reportCycles("LinearInterp 5 non-uniform", [](uint16_t i)
+                 { sink_i16 = THROTTLE_MAP.interp(i); },
+                 THROTTLE_TABLE[0].in + 1, THROTTLE_TABLE[4].in);
+    reportCycles("LinearInterp 30 non-uniform", [](uint16_t i)
+                 { sink_i16 = FINE_MAP.interp(i); },
+                 FINE_TABLE[0].in + 1, FINE_TABLE[29].in);
+    reportCycles("FixedSlopeInterp 30 non-uniform", [](uint16_t i)
+                 { sink_i16 = FINE_FIXED_MAP.interp(i); },
+                 FINE_TABLE[0].in + 1, FINE_TABLE[29].in);
+}
+
+void test_bench_rpm_maps(void)
+{
+    // sweep RPM along with the pedal so every segment pair gets hit
+    const uint16_t throttle = reportCycles("BilinearInterp throttle", [](uint16_t i)
+                                           { sink_i16 = THROTTLE_RPM_MAP.interp(i, static_cast<int16_t>(i * 32), active_profile_ptr->throttle); });
+    const uint16_t regen = reportCycles("BilinearInterp regen", [](uint16_t i)
+                                        { sink_i16 = REGEN_RPM_MAP.interp(i, static_cast<int16_t>(i * 32), active_profile_ptr->regen); });
+    // both maps together must stay a small fraction of schedulerPedalSend's tick
+    TEST_ASSERT_LESS_THAN(TICK_BUDGET_CYCLES / 100, static_cast<uint32_t>(throttle) + regen);
+}
+
+/**
+ * @brief The virtual filter interface SignalProcessing used before the static interface, kept here as the baseline
+ */
+class LegacyFilter
+{
+public:
+    virtual void addSample(uint16_t sample) = 0;
+    virtual uint16_t getFiltered() const = 0;
+};
+
+/**
+ * @brief ExponentialFilter<uint16_t, uint16_t> as it was on the virtual interface
+ */
+class LegacyExponentialFilter : public LegacyFilter
+{
+public:
+    void addSample(uint16_t sample) override
+    {
+        last_out = static_cast<uint16_t>(last_out * 31 + sample + 16) / 32;
+    }
+    uint16_t getFiltered() const override { return last_out; }
+
+private:
+    uint16_t last_out = 0; /**< Last output value */
+};
+
+LegacyExponentialFilter legacy_filters[3];                                                            /**< Pedal's three filters, virtual */
+LegacyFilter *volatile legacy_filter_ptr = &legacy_filters[0];                                        /**< Call through the base, as generic code had to */
+ExponentialFilter<uint16_t, uint16_t> static_filters[3];                                              /**< Pedal's three filters, static */
+FilterChain<AverageFilter<uint16_t, uint16_t, 4>, ExponentialFilter<uint16_t, uint16_t>> chain_filter; /**< Example two stage chain */
+AverageFilter<uint16_t, uint16_t, 16> average16_filter;                                               /**< Power of two window, mask and shift */
+AverageFilter<uint16_t, uint16_t, 10> average10_filter;                                               /**< Other window, compare and divide */
+PreciseExponentialFilter<uint16_t> precise_filters[3];                                                /**< Pedal's three filters, 16.16 state */
+PreciseExponentialFilter<uint16_t, uint32_t, 6, 1> precise_divided_filter;                            /**< Ratio sum not a power of two, 64-bit divide */
+MedianFilter<uint16_t, 3> median3_filter;                                                             /**< Spike rejection, 3 taps */
+MedianFilter<uint16_t, 5> median5_filter;                                                             /**< Spike rejection, 5 taps */
+FilterChain<MedianFilter<uint16_t, 3>, PreciseExponentialFilter<uint16_t>> input_filters[3];          /**< Pedal's three input filters as separate chains */
+FilterBank<3, 5, 5, 5, 3> input_bank;                                                                 /**< Pedal's input filters back when the hall sensor was on the ADC */
+BiquadFilter<uint16_t> biquad_df1{biquadLowPass<int16_t>(8, 0.7071, 10000)};                         /**< Throttle low-pass, direct form I */
+BiquadFilter<uint16_t, int16_t, int32_t, BiquadForm::DirectForm2Transposed> biquad_df2{biquadLowPass<int16_t>(8, 0.7071, 10000)}; /**< Throttle low-pass, transposed direct form II */
+
+void test_bench_filters(void)
+{
+    // Pedal::update used to add one sample to each of its three filters
+    const uint16_t legacy = reportCycles("virtual ExponentialFilter x3", [](uint16_t i)
+                                         { for (LegacyExponentialFilter &f : legacy_filters) f.addSample(i);
+                                           sink_i16 = legacy_filters[2].getFiltered(); });
+    reportCycles("virtual ExponentialFilter via base", [](uint16_t i)
+                 { legacy_filter_ptr->addSample(i);
+                   sink_i16 = legacy_filter_ptr->getFiltered(); });
+    const uint16_t crtp = reportCycles("static ExponentialFilter x3", [](uint16_t i)
+                                       { for (ExponentialFilter<uint16_t, uint16_t> &f : static_filters) f.addSample(i);
+                                         sink_i16 = static_filters[2].getFiltered(); });
+    const uint16_t precise = reportCycles("PreciseExponentialFilter x3", [](uint16_t i)
+                                          { for (PreciseExponentialFilter<uint16_t> &f : precise_filters) f.addSample(i);
+                                            sink_i16 = precise_filters[2].getFiltered(); });
+    reportCycles("PreciseExponentialFilter 6:1 divide", [](uint16_t i)
+                 { precise_divided_filter.addSample(i);
+                   sink_i16 = precise_divided_filter.getFiltered(); });
+    // scrambled samples, so every order of the window shows up; the networks have no data-dependent branch
+    const uint16_t median3 = reportCycles("MedianFilter 3", [](uint16_t i)
+                                          { median3_filter.addSample(static_cast<uint16_t>(i * 40503u) >> 6);
+                                            sink_i16 = median3_filter.getFiltered(); });
+    const uint16_t median5 = reportCycles("MedianFilter 5", [](uint16_t i)
+                                          { median5_filter.addSample(static_cast<uint16_t>(i * 40503u) >> 6);
+                                            sink_i16 = median5_filter.getFiltered(); });
+    const uint16_t chains = reportCycles("median 3 -> precise exponential x3", [](uint16_t i)
+                                         { for (auto &f : input_filters) f.addSample(static_cast<uint16_t>(i * 40503u) >> 6);
+                                           sink_i16 = input_filters[2].getFiltered(); });
+    const uint16_t bank = reportCycles("FilterBank 4 channels", [](uint16_t i)
+                                       { const uint16_t s = static_cast<uint16_t>(i * 40503u) >> 6;
+                                         const uint16_t samples[4] = {s, static_cast<uint16_t>(s ^ 0x155), static_cast<uint16_t>(s >> 1), i};
+                                         input_bank.addSamples(samples);
+                                         sink_i16 = input_bank.getFiltered(2); });
+    const uint16_t biquad = reportCycles("BiquadFilter DF1 Q2.14", [](uint16_t i)
+                                         { biquad_df1.addSample(i);
+                                           sink_i16 = biquad_df1.getFiltered(); });
+    reportCycles("BiquadFilter DF2T Q2.14", [](uint16_t i)
+                 { biquad_df2.addSample(i);
+                   sink_i16 = biquad_df2.getFiltered(); });
+    reportCycles("FilterChain average 4 -> exponential", [](uint16_t i)
+                 { chain_filter.addSample(i);
+                   sink_i16 = chain_filter.getFiltered(); });
+
+    // warm up first, so the benchmark is the steady state
+    for (uint8_t i = 0; i < 16; ++i)
+    {
+        average16_filter.addSample(i);
+        average10_filter.addSample(i);
+    }
+    const uint16_t average16 = reportCycles("AverageFilter 16", [](uint16_t i)
+                                            { average16_filter.addSample(i);
+                                              sink_i16 = average16_filter.getFiltered(); });
+    reportCycles("AverageFilter 10", [](uint16_t i)
+                 { average10_filter.addSample(i);
+                   sink_i16 = average10_filter.getFiltered(); });
+
+    char msg[80];
+    snprintf(msg, sizeof(msg), "RAM per filter: virtual %u, static %u bytes", static_cast<unsigned>(sizeof(LegacyExponentialFilter)), static_cast<unsigned>(sizeof(ExponentialFilter<uint16_t, uint16_t>)));
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_LESS_OR_EQUAL(legacy, crtp);
+    // running sum and shift, must be cheap enough for all three pedal inputs every loop
+    TEST_ASSERT_LESS_THAN(200, average16);
+    // shift-only update, Pedal::update runs it for every input every loop
+    TEST_ASSERT_LESS_THAN(600, precise);
+    TEST_ASSERT_LESS_THAN(150, median3);
+    TEST_ASSERT_LESS_THAN(300, median5);
+    // four channels in one pass must not cost more than three separate chains plus a fourth
+    TEST_ASSERT_LESS_OR_EQUAL(chains + chains / 3, bank);
+    // five 16x16 multiplies, once per scheduler tick
+    TEST_ASSERT_LESS_THAN(500, biquad);
+}
+
+volatile bool sink_bool; /**< Pin reads are written here so they aren't optimized away */
+
+void test_bench_gpio(void)
+{
+    pinMode(BRAKE_LIGHT, OUTPUT);
+    pinMode(DRIVE_MODE_BTN, INPUT);
+
+    // loop() wrote the brake light and read the drive mode button through the Arduino calls
+    const uint16_t arduino_write = reportCycles("digitalWrite", [](uint16_t i)
+                                                { digitalWrite(BRAKE_LIGHT, (i >> 6) & 1); }, 0, 1024);
+    const uint16_t arduino_read = reportCycles("digitalRead", [](uint16_t)
+                                               { sink_bool = digitalRead(DRIVE_MODE_BTN); }, 0, 1024);
+    // same pattern, the level changes every 64 calls so most writes are skipped
+    const uint16_t fast_write = reportCycles("FastPin write", [](uint16_t i)
+                                             { FastPin<BRAKE_LIGHT>::write((i >> 6) & 1); }, 0, 1024);
+    const uint16_t fast_toggle = reportCycles("FastPin write, changes every call", [](uint16_t i)
+                                              { FastPin<BRAKE_LIGHT>::write(i & 1); }, 0, 1024);
+    const uint16_t fast_read = reportCycles("FastPin read", [](uint16_t)
+                                            { sink_bool = FastPin<DRIVE_MODE_BTN>::read(); }, 0, 1024);
+    FastPin<BRAKE_LIGHT>::low();
+
+    // fast paths are a few instructions plus the level computation, the Arduino calls are dozens of cycles
+    TEST_ASSERT_LESS_THAN(arduino_write / 4, fast_toggle);
+    TEST_ASSERT_LESS_THAN(arduino_read / 4, fast_read);
+    TEST_ASSERT_LESS_OR_EQUAL(fast_toggle, fast_write);
+}
+
+HallSensor hall_sensor; /**< Fed with synthetic edges, the interrupt isn't started */
+
+void test_bench_hall_sensor(void)
+{
+    // one edge per call, 3ms apart (20000 RPM) so none is dropped as noise
+    const uint16_t edge = reportCycles("HallSensor edge", [](uint16_t i)
+                                       { hall_sensor.edge(static_cast<uint32_t>(i) * 3000); }, 0, 1024);
+    const uint16_t update = reportCycles("HallSensor update", [](uint16_t i)
+                                         { hall_sensor.edge(static_cast<uint32_t>(i) * 3000 + 3072000);
+                                           sink_i16 = hall_sensor.update(static_cast<uint32_t>(i) * 3000 + 3073000); }, 0, 1024);
+
+    TEST_ASSERT_LESS_THAN(100, edge); // runs in the interrupt, with micros() on top
+    TEST_ASSERT_LESS_THAN(TICK_BUDGET_CYCLES / 100, update);
+}
+
+volatile uint8_t sink_task; /**< Written by the scheduler tasks so they aren't optimized away */
+void benchTaskA() { sink_task = 1; }
+void benchTaskB() { sink_task = 2; }
+void benchTaskC() { sink_task = 3; }
+void benchTaskD() { sink_task = 4; }
+void benchTaskE() { sink_task = 5; }
+void benchTaskF() { sink_task = 6; }
+void benchTaskBms() { sink_task = 7; }
+
+unsigned long bench_time_us = 0; /**< Fake clock for the schedulers, advanced by one period before every update() */
+unsigned long benchTime() { return bench_time_us; }
+
+Scheduler<4, 3> dynamic_scheduler(SCHEDULER_PERIOD_US, 500, benchTime); /**< Same shape and tasks as main.cpp used to have */
+StaticScheduler<
+    SchedulerClock,
+    StaticTask<benchTaskA, McpIndex::Motor, 1>,
+    StaticTask<benchTaskBms, McpIndex::Bms, 5, true>,
+    StaticTask<benchTaskC, McpIndex::Datalogger, 1>,
+    StaticTask<benchTaskB, McpIndex::Motor, 1>,
+    StaticTask<benchTaskD, McpIndex::Datalogger, 1>,
+    StaticTask<benchTaskE, McpIndex::Datalogger, 10>,
+    StaticTask<benchTaskF, McpIndex::Datalogger, 1>>
+    static_scheduler(SchedulerClock(SCHEDULER_PERIOD_US, 500, benchTime)); /**< Same table as main.cpp, on the same clock as dynamic_scheduler */
+
+void test_bench_scheduler(void)
+{
+    dynamic_scheduler.addTask(McpIndex::Motor, benchTaskA, 1);
+    dynamic_scheduler.addTask(McpIndex::Motor, benchTaskB, 1);
+    dynamic_scheduler.addTask(McpIndex::Datalogger, benchTaskC, 1);
+    dynamic_scheduler.addTask(McpIndex::Datalogger, benchTaskD, 1);
+    dynamic_scheduler.addTask(McpIndex::Datalogger, benchTaskE, 10);
+    dynamic_scheduler.addTask(McpIndex::Datalogger, benchTaskF, 1);
+
+    // every call is a tick, so this is the dispatch overhead on top of the tasks
+    const uint16_t dynamic_tick = reportCycles("Scheduler tick", [](uint16_t)
+                                               { bench_time_us += SCHEDULER_PERIOD_US; dynamic_scheduler.update(); }, 0, 1024);
+    const uint16_t static_tick = reportCycles("StaticScheduler tick", [](uint16_t)
+                                              { bench_time_us += SCHEDULER_PERIOD_US; static_scheduler.update(); }, 0, 1024);
+
+    // STARTIN: BMS task running
+    dynamic_scheduler.addTask(McpIndex::Bms, benchTaskBms, 5);
+    static_scheduler.enable<benchTaskBms>();
+    const uint16_t dynamic_startin = reportCycles("Scheduler tick, STARTIN", [](uint16_t)
+                                                  { bench_time_us += SCHEDULER_PERIOD_US; dynamic_scheduler.update(); }, 0, 1024);
+    const uint16_t static_startin = reportCycles("StaticScheduler tick, STARTIN", [](uint16_t)
+                                                 { bench_time_us += SCHEDULER_PERIOD_US; static_scheduler.update(); }, 0, 1024);
+
+    // entering and leaving STARTIN
+    const uint16_t dynamic_toggle = reportCycles("Scheduler removeTask + addTask", [](uint16_t)
+                                                 { dynamic_scheduler.removeTask(McpIndex::Bms, benchTaskBms);
+                                                   dynamic_scheduler.addTask(McpIndex::Bms, benchTaskBms, 5); }, 0, 64);
+    const uint16_t static_toggle = reportCycles("StaticScheduler disable + enable", [](uint16_t)
+                                                { static_scheduler.disable<benchTaskBms>();
+                                                  static_scheduler.enable<benchTaskBms>(); }, 0, 64);
+
+    TEST_ASSERT_LESS_THAN(dynamic_tick, static_tick);
+    TEST_ASSERT_LESS_THAN(dynamic_startin, static_startin);
+    TEST_ASSERT_LESS_THAN(dynamic_toggle, static_toggle);
+}
+
+constexpr uint8_t adc_pins[3] = {APPS_5V, APPS_3V3, BRAKE_IN};                                   /**< Same inputs as main.cpp */
+constexpr uint8_t adc_oversample_bits[3] = {ADC_OVERSAMPLE_BITS, ADC_OVERSAMPLE_BITS, ADC_OVERSAMPLE_BITS}; /**< Same oversampling as main.cpp */
+AdcSequencer adc(adc_pins, adc_oversample_bits);                                                 /**< Background conversions of adc_pins */
+
+/**
+ * @brief Counts busy loop iterations for a while, interrupts on
+ * @param ms Duration to count for
+ * @return Number of iterations, fewer when interrupts take CPU time away
+ */
+uint32_t spinCount(const uint16_t ms)
+{
+    volatile uint32_t count = 0;
+    const uint32_t start = millis();
+    while (millis() - start < ms)
+        count = count + 1;
+    return count;
+}
+
+void test_bench_adc(void)
+{
+    const uint32_t idle_spins = spinCount(1000); // baseline, only the millis() interrupt running
+
+    // loop() used to read the inputs with blocking analogRead
+    const uint16_t blocking = reportCycles("analogRead x3", [](uint16_t)
+                                           { for (const uint8_t pin : adc_pins) sink_i16 = analogRead(pin); },
+                                           0, 64);
+
+    adc.begin(); // takes over the ADC, must run after every analogRead
+    delay(10);
+    const uint16_t sequenced = reportCycles("AdcSequencer read x3", [](uint16_t)
+                                            { for (uint8_t i = 0; i < 3; ++i) sink_i16 = adc.read(i); },
+                                            0, 64);
+
+    // rounds per second, every channel has a new value once per round
+    uint16_t rounds = 0;
+    adc.newRound();
+    const uint32_t start = millis();
+    while (millis() - start < 1000)
+        rounds += adc.newRound();
+    const uint16_t expected_rounds = 1000000UL / (static_cast<uint32_t>(adc.conversionsPerRound()) * ADC_CONVERSION_US);
+    char msg[80];
+    snprintf(msg, sizeof(msg), "ADC rounds per second: %u (expected %u), blocking loop limit: %lu per second", rounds, expected_rounds, static_cast<unsigned long>(F_CPU / blocking));
+    TEST_MESSAGE(msg);
+
+    // CPU time taken by the conversion interrupts, from the busy loop slowing down while they run
+    const uint32_t busy_spins = spinCount(1000);
+    const uint32_t isr_cycles_per_tick = TICK_BUDGET_CYCLES - static_cast<uint32_t>(static_cast<uint64_t>(TICK_BUDGET_CYCLES) * busy_spins / idle_spins);
+    snprintf(msg, sizeof(msg), "ADC interrupts: %lu cycles per tick, %u conversions per round", static_cast<unsigned long>(isr_cycles_per_tick), adc.conversionsPerRound());
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_LESS_THAN(200, sequenced);
+    TEST_ASSERT_GREATER_THAN(expected_rounds * 9 / 10, rounds);
+    TEST_ASSERT_LESS_THAN(TICK_BUDGET_CYCLES / 10, isr_cycles_per_tick); // one interrupt per 104us, oversampled or not
+}
+
+void setup()
+{
+    delay(2000); // wait for the serial monitor
+    // Timer1 normal mode, no prescaler: one count per CPU cycle
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);
+    overhead_cycles = measureCycles([](uint16_t i)
+                                    { sink_i16 = i; },
+                                    0, ADC_SIZE)
+                          .worst;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_bench_throttle_map);
+    RUN_TEST(test_bench_segment_lookup);
+    RUN_TEST(test_bench_rpm_maps);
+    RUN_TEST(test_bench_filters);
+    RUN_TEST(test_bench_gpio);
+    RUN_TEST(test_bench_hall_sensor);
+    RUN_TEST(test_bench_scheduler);
+    RUN_TEST(test_bench_adc); // last, takes over the ADC
+    UNITY_END();
+}
+
+void loop()
+{
+    // not used
+}
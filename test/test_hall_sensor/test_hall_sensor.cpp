@@ -0,0 +1,172 @@
+/**
+ * @file test_hall_sensor.cpp
+ * @author Planeson, Red Bird Racing
+ * @brief Host-side tests for the wheel speed measurement in HallSensor.hpp, run with `pio test -e native`
+ * @version 1.0
+ * @date 2026-10-16
+ * @see HallSensor.hpp
+ */
+#include <unity.h>
+#include <stdint.h>
+#include "HallSensor.hpp"
+
+constexpr uint32_t TICK_US = 10000; /**< update() period, one scheduler tick */
+
+/**
+ * @brief Exact wheel RPM of an edge period
+ * @param period_us Time between rising edges
+ * @return RPM as a double
+ */
+double exactRpm(const double period_us)
+{
+    return 60000000.0 / (period_us * HALL_PULSES_PER_REV);
+}
+
+/**
+ * @brief Feeds an edge train and the periodic update() calls to a sensor, in time order
+ * @param sensor The sensor
+ * @param start_us Time of the first edge
+ * @param period_us Time between edges
+ * @param jitter_us Every other edge comes this much later, 0 for a clean train
+ * @param duration_us Length of the train
+ * @param next_tick_us Time of the next update(), advanced by TICK_US
+ * @return RPM of the last update()
+ */
+uint16_t runTrain(HallSensor &sensor, const uint32_t start_us, const uint32_t period_us, const uint32_t jitter_us, const uint32_t duration_us, uint32_t &next_tick_us)
+{
+    uint16_t rpm = 0;
+    uint32_t edge_us = start_us;
+    uint32_t n = 0;
+    while (edge_us - start_us < duration_us)
+    {
+        while (static_cast<int32_t>(next_tick_us - edge_us) <= 0)
+        {
+            rpm = sensor.update(next_tick_us);
+            next_tick_us += TICK_US;
+        }
+        sensor.edge(edge_us + ((n & 1) ? jitter_us : 0));
+        ++n;
+        edge_us += period_us;
+    }
+    return rpm;
+}
+
+void setUp(void)
+{
+    // runs before each test
+    // optional in the sense that this can be empty
+    // to ensure it compiles on all platforms, do not remove this empty function
+}
+
+void tearDown(void)
+{
+    // runs after each test
+    // optional in the sense that this can be empty
+    // to ensure it compiles on all platforms, do not remove this empty function
+}
+
+void test_hall_constant_speed(void)
+{
+    // from walking pace to top speed, slower and faster than one edge per tick
+    const uint32_t periods_us[] = {500000, 123457, 48000, 9999, 4321, 2500};
+    for (const uint32_t period_us : periods_us)
+    {
+        HallSensor sensor;
+        uint32_t tick_us = 1000;
+        const uint16_t rpm = runTrain(sensor, 5000, period_us, 0, 3000000, tick_us);
+        TEST_ASSERT_FLOAT_WITHIN(1, exactRpm(period_us), rpm);
+    }
+}
+
+void test_hall_averages_jitter(void)
+{
+    // edges alternate 300us early and late, averaging over the edges in a tick must hide it
+    HallSensor sensor;
+    uint32_t tick_us = 0;
+    const uint16_t rpm = runTrain(sensor, 3000, 2500, 300, 1000000, tick_us);
+    TEST_ASSERT_FLOAT_WITHIN(1, exactRpm(2500), rpm);
+    // sub-microsecond period resolution from the averaging
+    TEST_ASSERT_UINT32_WITHIN(16, 2500 << HALL_PERIOD_FRACTION_BITS, sensor.getPeriod());
+}
+
+void test_hall_rejects_noise(void)
+{
+    // ringing after every real edge, inside HALL_MIN_PERIOD_US, must not count
+    HallSensor sensor;
+    uint32_t now_us = 1000;
+    uint16_t rpm = 0;
+    for (uint16_t n = 0; n < 100; ++n)
+    {
+        sensor.edge(now_us);
+        sensor.edge(now_us + 150);
+        sensor.edge(now_us + HALL_MIN_PERIOD_US - 1);
+        now_us += 20000;
+        rpm = sensor.update(now_us - 1);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1, exactRpm(20000), rpm);
+}
+
+void test_hall_start_and_stop(void)
+{
+    HallSensor sensor;
+    TEST_ASSERT_EQUAL_UINT16(0, sensor.update(0));
+    sensor.edge(10000);
+    TEST_ASSERT_EQUAL_UINT16(0, sensor.update(20000)); // a single edge has no period
+    sensor.edge(60000);
+    TEST_ASSERT_FLOAT_WITHIN(1, exactRpm(50000), sensor.update(70000));
+
+    // wheel stops: the reading falls once the next edge is overdue, without jumps up, then reads 0
+    uint16_t last = sensor.update(80000);
+    for (uint32_t now_us = 90000; now_us < 60000 + HALL_TIMEOUT_US; now_us += TICK_US)
+    {
+        const uint16_t rpm = sensor.update(now_us);
+        TEST_ASSERT_LESS_OR_EQUAL(last, rpm);
+        if (now_us - 60000 > 50000)
+            TEST_ASSERT_FLOAT_WITHIN(1, exactRpm(now_us - 60000), rpm);
+        last = rpm;
+    }
+    TEST_ASSERT_EQUAL_UINT16(0, sensor.update(60000 + HALL_TIMEOUT_US));
+
+    // moving again: first edge after the stop can't be timed against the old one
+    sensor.edge(5000000);
+    TEST_ASSERT_EQUAL_UINT16(0, sensor.update(5001000));
+    sensor.edge(5030000);
+    TEST_ASSERT_FLOAT_WITHIN(1, exactRpm(30000), sensor.update(5031000));
+}
+
+void test_hall_micros_wrap(void)
+{
+    // micros() wraps every ~71 minutes, the measurement must not notice
+    HallSensor sensor;
+    uint32_t tick_us = 0xFFFFFFFFUL - 500000;
+    const uint16_t rpm = runTrain(sensor, tick_us + 100, 7000, 0, 1000000, tick_us);
+    TEST_ASSERT_FLOAT_WITHIN(1, exactRpm(7000), rpm);
+}
+
+int runUnityTests(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_hall_constant_speed);
+    RUN_TEST(test_hall_averages_jitter);
+    RUN_TEST(test_hall_rejects_noise);
+    RUN_TEST(test_hall_start_and_stop);
+    RUN_TEST(test_hall_micros_wrap);
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup()
+{
+    runUnityTests();
+}
+
+void loop()
+{
+    // not used
+}
+#else
+int main(void)
+{
+    return runUnityTests();
+}
+#endif
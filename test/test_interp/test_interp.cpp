@@ -0,0 +1,362 @@
+/**
+ * @file test_interp.cpp
+ * @author Planeson, Red Bird Racing
+ * @brief Host-side tests for the interpolation helpers in Interp.hpp, run with `pio test -e native`
+ * @version 1.2
+ * @date 2026-10-16
+ * @see Interp.hpp, Curves.hpp
+ */
+#include <unity.h>
+#include <stdint.h>
+#include "Interp.hpp"
+#include "Curves.hpp"
+
+constexpr uint16_t ADC_SIZE = ADC_MAX + 1; /**< Number of ADC values at ADC_BITS */
+constexpr uint16_t LUT_SIZE = 1024;        /**< Number of FlashLut entries, same as ADC_LUT_SIZE in Pedal.hpp */
+constexpr uint16_t LUT_STEP_MASK = (1u << ADC_OVERSAMPLE_BITS) - 1; /**< Input bits the FlashLuts drop */
+constexpr uint16_t INPUT_MAX = 0xFFFF; /**< Largest uint16_t input */
+
+// same template arguments as the maps in Pedal.hpp
+constexpr LinearInterp<uint16_t, int16_t, int32_t, 5> THROTTLE_MAP{THROTTLE_TABLE};
+constexpr LinearInterp<uint16_t, int16_t, int32_t, 5> BRAKE_MAP{BRAKE_TABLE};
+constexpr LinearInterp<uint16_t, uint16_t, uint32_t, 3> APPS_3V3_SCALE_MAP{APPS_3V3_SCALE_TABLE};
+
+constexpr FixedSlopeInterp<uint16_t, int16_t, int32_t, 5> THROTTLE_FIXED_MAP{THROTTLE_TABLE};
+constexpr FixedSlopeInterp<uint16_t, int16_t, int32_t, 5> BRAKE_FIXED_MAP{BRAKE_TABLE};
+constexpr FixedSlopeInterp<uint16_t, uint16_t, uint32_t, 3> APPS_3V3_SCALE_FIXED_MAP{APPS_3V3_SCALE_TABLE};
+constexpr FixedSlopeInterp<uint16_t, int16_t, int32_t, 5> CURVE_FIXED_MAP{CURVE_TABLE};
+constexpr LinearInterp<uint16_t, int16_t, int32_t, 5> CURVE_MAP{CURVE_TABLE};
+
+// wide segments (15000 inputs) can't be exact, but must stay within 1
+static_assert(CURVE_FIXED_MAP.maxError() <= 1, "FixedSlopeInterp error bound exceeded on CURVE_TABLE");
+
+/** 30-point uniform table, every 30 ADC counts from 100 */
+constexpr TablePoint<uint16_t, int16_t> FINE_UNIFORM_TABLE[30] = {
+    {100, 0}, {130, 50}, {160, 120}, {190, 300}, {220, 500}, {250, 800}, {280, 1200}, {310, 1700}, {340, 2300}, {370, 3000},
+    {400, 3800}, {430, 4700}, {460, 5700}, {490, 6800}, {520, 8000}, {550, 9300}, {580, 10700}, {610, 12200}, {640, 13800}, {670, 15500},
+    {700, 17300}, {730, 19200}, {760, 21200}, {790, 23300}, {820, 25500}, {850, 27300}, {880, 28900}, {910, 30300}, {940, 31500}, {970, 32500}};
+
+/** 30-point non-uniform table, denser at the start, decreasing output */
+constexpr TablePoint<uint16_t, int16_t> FINE_TABLE[30] = {
+    {120, 0}, {122, -100}, {125, -300}, {129, -700}, {134, -1300}, {140, -2100}, {147, -3100}, {155, -4300}, {164, -5700}, {174, -7300},
+    {185, -9100}, {197, -11000}, {210, -13000}, {224, -15000}, {239, -17000}, {255, -19000}, {272, -21000}, {290, -22900}, {309, -24700}, {329, -26400},
+    {350, -27900}, {372, -29200}, {395, -30300}, {419, -31100}, {444, -31700}, {470, -32100}, {497, -32300}, {525, -32400}, {554, -32450}, {584, -32500}};
+
+constexpr LinearInterp<uint16_t, int16_t, int32_t, 30> FINE_UNIFORM_MAP{FINE_UNIFORM_TABLE};
+constexpr LinearInterp<uint16_t, int16_t, int32_t, 30> FINE_MAP{FINE_TABLE};
+constexpr FixedSlopeInterp<uint16_t, int16_t, int32_t, 30> FINE_UNIFORM_FIXED_MAP{FINE_UNIFORM_TABLE};
+constexpr FixedSlopeInterp<uint16_t, int16_t, int32_t, 30> FINE_FIXED_MAP{FINE_TABLE};
+
+/**
+ * @brief Reference interpolation with a plain linear segment scan, as LinearInterp did before the segment lookup
+ */
+template <uint8_t size>
+int16_t referenceInterp(const TablePoint<uint16_t, int16_t> (&table)[size], const uint16_t input)
+{
+    if (input <= table[0].in)
+        return table[0].out;
+    if (input >= table[size - 1].in)
+        return table[size - 1].out;
+    for (uint8_t i = 1; i < size; ++i)
+    {
+        if (input < table[i].in)
+            return table[i - 1].out + (static_cast<int32_t>(input - table[i - 1].in) * (table[i].out - table[i - 1].out)) / (table[i].in - table[i - 1].in);
+    }
+    return table[size - 1].out;
+}
+
+constexpr BilinearInterp<uint16_t, int16_t, int16_t, int32_t, 5, 3> THROTTLE_RPM_MAP{THROTTLE_APPS_AXIS, THROTTLE_RPM_AXIS};
+constexpr BilinearInterp<uint16_t, int16_t, int16_t, int32_t, 5, 3> REGEN_RPM_MAP{REGEN_BRAKE_AXIS, REGEN_RPM_AXIS};
+
+/** Grid with full-scale steps between neighbours and a negative axis, to stress the fraction precision */
+constexpr uint16_t STEEP_X_AXIS[3] = {0, 1, 1023};
+constexpr int16_t STEEP_Y_AXIS[4] = {-32768, -100, 0, 32767};
+constexpr int16_t STEEP_GRID[4][3] = {
+    {-32767, 32767, -32767},
+    {32767, -32767, 0},
+    {0, 12345, -23456},
+    {32767, -32767, 32767}};
+constexpr BilinearInterp<uint16_t, int16_t, int16_t, int32_t, 3, 4> STEEP_MAP{STEEP_X_AXIS, STEEP_Y_AXIS};
+
+/**
+ * @brief Reference bilinear interpolation in double precision, clamping like BilinearInterp
+ */
+template <uint8_t size_x, uint8_t size_y>
+double referenceBilinear(const uint16_t (&x_axis)[size_x], const int16_t (&y_axis)[size_y], const int16_t (&grid)[size_y][size_x], double x, double y)
+{
+    x = x < x_axis[0] ? x_axis[0] : (x > x_axis[size_x - 1] ? x_axis[size_x - 1] : x);
+    y = y < y_axis[0] ? y_axis[0] : (y > y_axis[size_y - 1] ? y_axis[size_y - 1] : y);
+    uint8_t i = 1;
+    while (i < size_x - 1 && x >= x_axis[i])
+        ++i;
+    uint8_t j = 1;
+    while (j < size_y - 1 && y >= y_axis[j])
+        ++j;
+    const double fx = (x - x_axis[i - 1]) / (x_axis[i] - x_axis[i - 1]);
+    const double fy = (y - y_axis[j - 1]) / (y_axis[j] - y_axis[j - 1]);
+    const double lower = grid[j - 1][i - 1] + (grid[j - 1][i] - grid[j - 1][i - 1]) * fx;
+    const double upper = grid[j][i - 1] + (grid[j][i] - grid[j][i - 1]) * fx;
+    return lower + (upper - lower) * fy;
+}
+
+constexpr FlashLut<int16_t, LUT_SIZE, ADC_OVERSAMPLE_BITS> THROTTLE_LUT PROGMEM{THROTTLE_MAP};
+constexpr FlashLut<int16_t, LUT_SIZE, ADC_OVERSAMPLE_BITS> BRAKE_LUT PROGMEM{BRAKE_MAP};
+constexpr FlashLut<uint16_t, LUT_SIZE, ADC_OVERSAMPLE_BITS> APPS_3V3_SCALE_LUT PROGMEM{APPS_3V3_SCALE_MAP};
+constexpr FlashAxisLut<LUT_SIZE, ADC_OVERSAMPLE_BITS> THROTTLE_AXIS_LUT PROGMEM{THROTTLE_RPM_MAP};
+constexpr FlashAxisLut<LUT_SIZE, ADC_OVERSAMPLE_BITS> REGEN_AXIS_LUT PROGMEM{REGEN_RPM_MAP};
+
+void setUp(void)
+{
+    // runs before each test
+    // optional in the sense that this can be empty
+    // to ensure it compiles on all platforms, do not remove this empty function
+}
+
+void tearDown(void)
+{
+    // runs after each test
+    // optional in the sense that this can be empty
+    // to ensure it compiles on all platforms, do not remove this empty function
+}
+
+void test_flash_lut_throttle(void)
+{
+    for (uint16_t i = 0; i < ADC_SIZE; ++i)
+        TEST_ASSERT_EQUAL_INT16(THROTTLE_MAP.interp(i & ~LUT_STEP_MASK), THROTTLE_LUT.lookup(i));
+}
+
+void test_flash_lut_brake(void)
+{
+    for (uint16_t i = 0; i < ADC_SIZE; ++i)
+        TEST_ASSERT_EQUAL_INT16(BRAKE_MAP.interp(i & ~LUT_STEP_MASK), BRAKE_LUT.lookup(i));
+}
+
+void test_flash_lut_apps_3v3_scale(void)
+{
+    for (uint16_t i = 0; i < ADC_SIZE; ++i)
+        TEST_ASSERT_EQUAL_UINT16(APPS_3V3_SCALE_MAP.interp(i & ~LUT_STEP_MASK), APPS_3V3_SCALE_LUT.lookup(i));
+}
+
+void test_flash_lut_clamp_above(void)
+{
+    // inputs past the table clamp to the last entry, same as interp() clamping above the last point
+    TEST_ASSERT_EQUAL_INT16(THROTTLE_MAP.interp(ADC_SIZE), THROTTLE_LUT.lookup(ADC_SIZE));
+    TEST_ASSERT_EQUAL_INT16(BRAKE_MAP.interp(INPUT_MAX), BRAKE_LUT.lookup(INPUT_MAX));
+    TEST_ASSERT_EQUAL_UINT16(APPS_3V3_SCALE_MAP.interp(INPUT_MAX), APPS_3V3_SCALE_LUT.lookup(INPUT_MAX));
+}
+
+void test_fixed_slope_matches_interp(void)
+{
+    // full input range, including clamping on both ends
+    for (uint32_t i = 0; i <= INPUT_MAX; ++i)
+    {
+        TEST_ASSERT_EQUAL_INT16(THROTTLE_MAP.interp(i), THROTTLE_FIXED_MAP.interp(i));
+        TEST_ASSERT_EQUAL_INT16(BRAKE_MAP.interp(i), BRAKE_FIXED_MAP.interp(i));
+        TEST_ASSERT_EQUAL_UINT16(APPS_3V3_SCALE_MAP.interp(i), APPS_3V3_SCALE_FIXED_MAP.interp(i));
+    }
+}
+
+void test_fixed_slope_wide_segments(void)
+{
+    for (uint32_t i = 0; i <= INPUT_MAX; ++i)
+        TEST_ASSERT_INT16_WITHIN(1, CURVE_MAP.interp(i), CURVE_FIXED_MAP.interp(i));
+}
+
+void test_fixed_slope_shift(void)
+{
+    // largest brake delta is 15000, 15000 * 2^17 + 2^17 + 30 fits in int32, 2^18 doesn't
+    TEST_ASSERT_EQUAL_UINT8(17, BRAKE_FIXED_MAP.fractionBits());
+    TEST_ASSERT_EQUAL_UINT8(0, BRAKE_FIXED_MAP.maxError());
+}
+
+void test_segment_uniform_detection(void)
+{
+    TEST_ASSERT_TRUE(BRAKE_MAP.uniform());
+    TEST_ASSERT_TRUE(CURVE_MAP.uniform());
+    TEST_ASSERT_TRUE(FINE_UNIFORM_MAP.uniform());
+    // rounding of APPS_5V_TABLE_INVERTED_MAP can break the spacing, depending on ADC_BITS
+    bool throttle_spaced = true;
+    for (uint8_t i = 2; i < 5; ++i)
+        throttle_spaced &= THROTTLE_TABLE[i].in - THROTTLE_TABLE[i - 1].in == THROTTLE_TABLE[1].in - THROTTLE_TABLE[0].in;
+    TEST_ASSERT_EQUAL(throttle_spaced, THROTTLE_MAP.uniform());
+    TEST_ASSERT_FALSE(APPS_3V3_SCALE_MAP.uniform());
+    TEST_ASSERT_FALSE(FINE_MAP.uniform());
+}
+
+void test_segment_lookup_matches_scan(void)
+{
+    for (uint32_t i = 0; i <= INPUT_MAX; ++i)
+    {
+        TEST_ASSERT_EQUAL_INT16(referenceInterp(THROTTLE_TABLE, i), THROTTLE_MAP.interp(i));
+        TEST_ASSERT_EQUAL_INT16(referenceInterp(BRAKE_TABLE, i), BRAKE_MAP.interp(i));
+        TEST_ASSERT_EQUAL_INT16(referenceInterp(CURVE_TABLE, i), CURVE_MAP.interp(i));
+        TEST_ASSERT_EQUAL_INT16(referenceInterp(FINE_UNIFORM_TABLE, i), FINE_UNIFORM_MAP.interp(i));
+        TEST_ASSERT_EQUAL_INT16(referenceInterp(FINE_TABLE, i), FINE_MAP.interp(i));
+        TEST_ASSERT_EQUAL_INT16(referenceInterp(FINE_UNIFORM_TABLE, i), FINE_UNIFORM_FIXED_MAP.interp(i));
+        TEST_ASSERT_EQUAL_INT16(referenceInterp(FINE_TABLE, i), FINE_FIXED_MAP.interp(i));
+    }
+}
+
+void test_bilinear_grid_points_exact(void)
+{
+    for (uint8_t j = 0; j < 3; ++j)
+    {
+        for (uint8_t i = 0; i < 5; ++i)
+        {
+            TEST_ASSERT_EQUAL_INT16(ENDURANCE_PROFILE.throttle[j][i], THROTTLE_RPM_MAP.interp(THROTTLE_APPS_AXIS[i], THROTTLE_RPM_AXIS[j], ENDURANCE_PROFILE.throttle));
+            TEST_ASSERT_EQUAL_INT16(ENDURANCE_PROFILE.regen[j][i], REGEN_RPM_MAP.interp(REGEN_BRAKE_AXIS[i], REGEN_RPM_AXIS[j], ENDURANCE_PROFILE.regen));
+        }
+    }
+    for (uint8_t j = 0; j < 4; ++j)
+    {
+        for (uint8_t i = 0; i < 3; ++i)
+            TEST_ASSERT_EQUAL_INT16(STEEP_GRID[j][i], STEEP_MAP.interp(STEEP_X_AXIS[i], STEEP_Y_AXIS[j], STEEP_GRID));
+    }
+}
+
+void test_bilinear_matches_reference(void)
+{
+    for (uint16_t x = 0; x < ADC_SIZE; ++x)
+    {
+        for (int32_t y = -32768; y <= 32767; y += 97)
+        {
+            TEST_ASSERT_FLOAT_WITHIN(2, referenceBilinear(THROTTLE_APPS_AXIS, THROTTLE_RPM_AXIS, ENDURANCE_PROFILE.throttle, x, y), THROTTLE_RPM_MAP.interp(x, y, ENDURANCE_PROFILE.throttle));
+            TEST_ASSERT_FLOAT_WITHIN(2, referenceBilinear(REGEN_BRAKE_AXIS, REGEN_RPM_AXIS, ENDURANCE_PROFILE.regen, x, y), REGEN_RPM_MAP.interp(x, y, ENDURANCE_PROFILE.regen));
+            TEST_ASSERT_FLOAT_WITHIN(5, referenceBilinear(STEEP_X_AXIS, STEEP_Y_AXIS, STEEP_GRID, x, y), STEEP_MAP.interp(x, y, STEEP_GRID));
+        }
+    }
+}
+
+void test_bilinear_matches_1d_curves(void)
+{
+    // rows of the default grids are the 1D curves, so off-grid RPMs must match them too
+    for (uint16_t x = 0; x < ADC_SIZE; ++x)
+    {
+        TEST_ASSERT_INT_WITHIN(1, THROTTLE_MAP.interp(x), THROTTLE_RPM_MAP.interp(x, 12345, ENDURANCE_PROFILE.throttle));
+        TEST_ASSERT_INT_WITHIN(1, BRAKE_MAP.interp(x), REGEN_RPM_MAP.interp(x, 20000, ENDURANCE_PROFILE.regen));
+    }
+}
+
+void test_flash_axis_lut_matches_interp(void)
+{
+    // located from flash, the grids give interp() of the input with the dropped bits cleared, at every RPM row and between them
+    const int16_t rpms[] = {-1000, 0, 3500, 5000, 12345, 32767};
+    for (uint16_t x = 0; x < ADC_SIZE; ++x)
+    {
+        for (const int16_t rpm : rpms)
+        {
+            TEST_ASSERT_EQUAL_INT16(THROTTLE_RPM_MAP.interp(x & ~LUT_STEP_MASK, rpm, ENDURANCE_PROFILE.throttle),
+                                    THROTTLE_RPM_MAP.interpAt(THROTTLE_AXIS_LUT.lookup(x), rpm, ENDURANCE_PROFILE.throttle));
+            TEST_ASSERT_EQUAL_INT16(REGEN_RPM_MAP.interp(x & ~LUT_STEP_MASK, rpm, ENDURANCE_PROFILE.regen),
+                                    REGEN_RPM_MAP.interpAt(REGEN_AXIS_LUT.lookup(x), rpm, ENDURANCE_PROFILE.regen));
+        }
+    }
+    TEST_ASSERT_EQUAL_INT16(THROTTLE_RPM_MAP.interp(INPUT_MAX, 0, ENDURANCE_PROFILE.throttle),
+                            THROTTLE_RPM_MAP.interpAt(THROTTLE_AXIS_LUT.lookup(INPUT_MAX), 0, ENDURANCE_PROFILE.throttle));
+}
+
+void test_regen_fades_in_with_rpm(void)
+{
+    const uint16_t full_brake = REGEN_BRAKE_AXIS[4];
+    // no regen at or below the first breakpoint, including reverse
+    TEST_ASSERT_EQUAL_INT16(0, REGEN_RPM_MAP.interp(full_brake, -32768, ENDURANCE_PROFILE.regen));
+    TEST_ASSERT_EQUAL_INT16(0, REGEN_RPM_MAP.interp(full_brake, REGEN_RPM_AXIS[0], ENDURANCE_PROFILE.regen));
+    // regen grows monotonically (more negative) up to the second breakpoint, without jumps
+    int16_t last = 0;
+    for (int16_t rpm = REGEN_RPM_AXIS[0]; rpm <= REGEN_RPM_AXIS[1]; ++rpm)
+    {
+        const int16_t regen = REGEN_RPM_MAP.interp(full_brake, rpm, ENDURANCE_PROFILE.regen);
+        TEST_ASSERT_LESS_OR_EQUAL(last, regen);
+        TEST_ASSERT_INT_WITHIN(20, last, regen);
+        last = regen;
+    }
+    TEST_ASSERT_EQUAL_INT16(BRAKE_TABLE[4].out, last);
+}
+
+void test_profiles_idle_at_rest(void)
+{
+    // every profile gives no torque with the pedals released and no regen at or below ~10km/h
+    const TorqueProfile *const profiles[] = {&ENDURANCE_PROFILE, &ACCELERATION_PROFILE, &SKIDPAD_PROFILE};
+    for (const TorqueProfile *profile : profiles)
+    {
+        for (int32_t rpm = -32768; rpm <= 32767; rpm += 97)
+        {
+            TEST_ASSERT_EQUAL_INT16(0, THROTTLE_RPM_MAP.interp(THROTTLE_APPS_AXIS[0], rpm, profile->throttle));
+            TEST_ASSERT_EQUAL_INT16(0, REGEN_RPM_MAP.interp(REGEN_BRAKE_AXIS[0], rpm, profile->regen));
+        }
+        for (uint16_t x = 0; x < ADC_SIZE; ++x)
+        {
+            TEST_ASSERT_EQUAL_INT16(0, REGEN_RPM_MAP.interp(x, REGEN_RPM_AXIS[0], profile->regen));
+            TEST_ASSERT_GREATER_OR_EQUAL_INT16(0, THROTTLE_RPM_MAP.interp(x, 0, profile->throttle));
+            TEST_ASSERT_LESS_OR_EQUAL_INT16(0, REGEN_RPM_MAP.interp(x, 32767, profile->regen));
+        }
+    }
+}
+
+void test_calibration_validation(void)
+{
+    TEST_ASSERT_TRUE(validApps3v3Scale(APPS_3V3_SCALE_TABLE));
+
+    TorqueProfile profile = ENDURANCE_PROFILE;
+    TEST_ASSERT_TRUE(validProfile(profile));
+    profile.throttle[1][3] = static_cast<int16_t>(profile.throttle[1][2] - 1); // dip in the throttle curve
+    TEST_ASSERT_FALSE(validProfile(profile));
+    profile = ENDURANCE_PROFILE;
+    profile.regen[2][4] = -32768; // past the torque limit
+    TEST_ASSERT_FALSE(validProfile(profile));
+    profile = ENDURANCE_PROFILE;
+    profile.regen[1][2] = 0; // regen weaker with more brake
+    TEST_ASSERT_FALSE(validProfile(profile));
+    profile = ENDURANCE_PROFILE;
+    profile.regen[0][4] = -100; // regen below MIN_REGEN_KMH
+    TEST_ASSERT_FALSE(validProfile(profile));
+    profile = ENDURANCE_PROFILE;
+    profile.throttle[2][0] = 100; // torque with the pedal released
+    TEST_ASSERT_FALSE(validProfile(profile));
+
+    TablePoint<uint16_t, uint16_t> scale[3] = {APPS_3V3_SCALE_TABLE[0], APPS_3V3_SCALE_TABLE[1], APPS_3V3_SCALE_TABLE[2]};
+    scale[1].in = scale[0].in; // zero-width segment
+    TEST_ASSERT_FALSE(validApps3v3Scale(scale));
+    scale[1] = APPS_3V3_SCALE_TABLE[1];
+    scale[2].out = ADC_MAX + 1; // outside the ADC range
+    TEST_ASSERT_FALSE(validApps3v3Scale(scale));
+}
+
+int runUnityTests(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_flash_lut_throttle);
+    RUN_TEST(test_flash_lut_brake);
+    RUN_TEST(test_flash_lut_apps_3v3_scale);
+    RUN_TEST(test_flash_lut_clamp_above);
+    RUN_TEST(test_fixed_slope_matches_interp);
+    RUN_TEST(test_fixed_slope_wide_segments);
+    RUN_TEST(test_fixed_slope_shift);
+    RUN_TEST(test_segment_uniform_detection);
+    RUN_TEST(test_segment_lookup_matches_scan);
+    RUN_TEST(test_bilinear_grid_points_exact);
+    RUN_TEST(test_bilinear_matches_reference);
+    RUN_TEST(test_bilinear_matches_1d_curves);
+    RUN_TEST(test_flash_axis_lut_matches_interp);
+    RUN_TEST(test_regen_fades_in_with_rpm);
+    RUN_TEST(test_profiles_idle_at_rest);
+    RUN_TEST(test_calibration_validation);
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup()
+{
+    runUnityTests();
+}
+
+void loop()
+{
+    // not used
+}
+#else
+int main(void)
+{
+    return runUnityTests();
+}
+#endif
@@ -0,0 +1,487 @@
+/**
+ * @file test_scheduler.cpp
+ * @author Planeson, Red Bird Racing
+ * @brief Host-side tests for the dispatch order, phases, priorities, load shedding and multi-rate tables of StaticScheduler, the phases of Scheduler and SchedulerStats, run with `pio test -e native`
+ * @details Tasks advance a simulated clock by their execution time. Overruns are injected by making the telemetry task
+ * take longer than a period, and the torque task records how late after its tick it ran.
+ * On TimerClock, the compare match is simulated by calling TimerClock::handleInterrupt(), also from a task to overrun it.
+ * @version 1.5
+ * @date 2026-10-16
+ * @see StaticScheduler.hpp
+ */
+#include <unity.h>
+#include <stdint.h>
+#include "StaticScheduler.hpp"
+#include "Scheduler.hpp"
+#include "SchedulerStats.hpp"
+#include "TimerClock.hpp"
+
+constexpr uint32_t PERIOD_US = 10000;   /**< Scheduler tick, SCHEDULER_PERIOD_US */
+constexpr uint32_t BUDGET_US = 8000;    /**< SCHEDULER_BUDGET_US */
+constexpr uint32_t POLL_US = 20;        /**< Time between update() calls while idle */
+constexpr uint32_t TORQUE_US = 200;     /**< Execution time of the torque command */
+constexpr uint32_t HOUSEKEEP_US = 1000; /**< Execution time of the Normal priority task */
+constexpr uint32_t TELEMETRY_US = 1500; /**< Execution time of the telemetry task */
+constexpr uint32_t OVERRUN_US = 19000;  /**< Execution time of the telemetry task when an overrun is injected */
+constexpr uint16_t SIM_TICKS = 200;     /**< Ticks per simulation */
+constexpr uint16_t OVERRUN_EVERY = 10;  /**< An overrun is injected every this many ticks */
+
+uint32_t sim_us;          /**< Simulated time */
+uint32_t first_tick_us;   /**< Time the first tick was due, ticks are due every PERIOD_US after it */
+uint16_t torque_runs;     /**< Number of torque commands sent */
+uint32_t torque_late[SIM_TICKS]; /**< Lateness of each torque command after its tick was due */
+uint16_t telemetry_runs;  /**< Number of telemetry frames sent */
+uint16_t housekeep_runs;  /**< Number of housekeeping runs */
+uint16_t rate_runs[3];    /**< Number of runs of each countTask */
+uint16_t sim_tick;        /**< Tick being run by runLoggedTicks, counted from 0 */
+uint8_t call_log[16];     /**< Index of each logTask call, in call order */
+uint8_t call_count;       /**< Number of logTask calls */
+uint16_t log_runs[5];     /**< Number of runs of each logTask */
+uint16_t log_first[5];    /**< Tick of the first run of each logTask, UINT16_MAX before it */
+
+/**
+ * @brief micros() on the simulated time
+ * @return Simulated time
+ */
+unsigned long simMicros()
+{
+    return sim_us;
+}
+
+void torqueTask()
+{
+    if (torque_runs < SIM_TICKS)
+        torque_late[torque_runs] = (sim_us - first_tick_us) % PERIOD_US;
+    ++torque_runs;
+    sim_us += TORQUE_US;
+}
+
+void telemetryTask()
+{
+    ++telemetry_runs;
+    sim_us += telemetry_runs % OVERRUN_EVERY == 0 ? OVERRUN_US : TELEMETRY_US;
+}
+
+/**
+ * @brief Torque task on TimerClock, overruns past the next compare match every OVERRUN_EVERY runs
+ */
+void timerTorqueTask()
+{
+    ++torque_runs;
+    if (torque_runs % OVERRUN_EVERY == 0)
+        TimerClock::handleInterrupt();
+}
+
+void housekeepTask()
+{
+    ++housekeep_runs;
+    sim_us += HOUSEKEEP_US;
+}
+
+/**
+ * @brief Task of a multi-rate table, counts its runs
+ * @tparam N Index in rate_runs
+ */
+template <uint8_t N>
+void countTask()
+{
+    ++rate_runs[N];
+    sim_us += 50;
+}
+
+/**
+ * @brief Task that logs when it runs, takes no time
+ * @tparam N Index in log_runs and log_first
+ */
+template <uint8_t N>
+void logTask()
+{
+    if (call_count < sizeof(call_log))
+        call_log[call_count++] = N;
+    if (log_first[N] == UINT16_MAX)
+        log_first[N] = sim_tick;
+    ++log_runs[N];
+}
+
+/**
+ * @brief Runs exactly one tick per update() call
+ * @tparam SCHEDULER Scheduler or StaticScheduler type
+ * @param scheduler Scheduler under test
+ * @param ticks Number of ticks to run
+ */
+template <typename SCHEDULER>
+void runLoggedTicks(SCHEDULER &scheduler, const uint16_t ticks)
+{
+    for (sim_tick = 0; sim_tick < ticks; ++sim_tick)
+    {
+        sim_us += PERIOD_US;
+        scheduler.update();
+    }
+}
+
+/**
+ * @brief Reads a little endian field of a frame payload
+ * @param data Payload to read
+ * @param index Index of the low byte
+ * @return Field value
+ */
+uint16_t frameField(const uint8_t (&data)[SCHEDULER_STATS_FRAME_BYTES], const uint8_t index)
+{
+    return static_cast<uint16_t>(data[index] | (data[index + 1] << 8));
+}
+
+/**
+ * @brief Calls update() until SIM_TICKS torque commands were sent
+ * @tparam SCHEDULER StaticScheduler type
+ * @param scheduler Scheduler under test
+ */
+template <typename SCHEDULER>
+void runTicks(SCHEDULER &scheduler)
+{
+    scheduler.synchronize(simMicros);
+    first_tick_us = sim_us + PERIOD_US;
+    while (torque_runs < SIM_TICKS)
+    {
+        scheduler.update();
+        sim_us += POLL_US;
+    }
+}
+
+/**
+ * @brief Counts torque commands later than one poll after their tick
+ * @return Number of late commands
+ */
+uint16_t lateTorqueCount()
+{
+    uint16_t late = 0;
+    for (uint16_t i = 0; i < SIM_TICKS; ++i)
+    {
+        if (torque_late[i] > POLL_US)
+            ++late;
+    }
+    return late;
+}
+
+void setUp(void)
+{
+    // runs before each test
+    sim_us = 1000;
+    torque_runs = 0;
+    telemetry_runs = 0;
+    housekeep_runs = 0;
+    for (uint8_t i = 0; i < 3; ++i)
+        rate_runs[i] = 0;
+    call_count = 0;
+    for (uint8_t i = 0; i < 5; ++i)
+    {
+        log_runs[i] = 0;
+        log_first[i] = UINT16_MAX;
+    }
+}
+
+void tearDown(void)
+{
+    // runs after each test
+    // optional in the sense that this can be empty
+    // to ensure it compiles on all platforms, do not remove this empty function
+}
+
+void test_dispatch_order(void)
+{
+    // critical tasks first, then the others in table order, every tick
+    StaticScheduler<
+        SchedulerClock,
+        StaticTask<logTask<0>, McpIndex::Motor, 1>,
+        CriticalTask<logTask<1>, McpIndex::Motor>,
+        LowPriorityTask<logTask<2>, McpIndex::Datalogger>,
+        StaticTask<logTask<3>, McpIndex::Bms, 1>>
+        scheduler(SchedulerClock(PERIOD_US, 0, simMicros), BUDGET_US);
+    scheduler.synchronize(simMicros);
+    runLoggedTicks(scheduler, 2);
+
+    const uint8_t expected[] = {1, 0, 2, 3, 1, 0, 2, 3};
+    TEST_ASSERT_EQUAL_UINT8(sizeof(expected), call_count);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, call_log, sizeof(expected));
+}
+
+void test_static_phases(void)
+{
+    // shortest interval placed first, then each on the phase meeting the fewest placed tasks, fixed phases kept
+    using Phased = StaticScheduler<
+        SchedulerClock,
+        StaticTask<logTask<0>, McpIndex::Motor, 4>,
+        StaticTask<logTask<1>, McpIndex::Motor, 2>,
+        StaticTask<logTask<2>, McpIndex::Motor, 4>,
+        StaticTask<logTask<3>, McpIndex::Bms, 4, false, 1>,
+        StaticTask<logTask<4>, McpIndex::Motor, 1>>;
+    TEST_ASSERT_EQUAL_UINT16(3, Phased::getPhase(0)); // 1 is taken by the fixed phase on another MCP2515
+    TEST_ASSERT_EQUAL_UINT16(0, Phased::getPhase(1));
+    TEST_ASSERT_EQUAL_UINT16(1, Phased::getPhase(2)); // meets the fixed phase, but only on another MCP2515
+    TEST_ASSERT_EQUAL_UINT16(1, Phased::getPhase(3));
+    TEST_ASSERT_EQUAL_UINT16(0, Phased::getPhase(4));
+
+    Phased scheduler(SchedulerClock(PERIOD_US, 0, simMicros));
+    scheduler.synchronize(simMicros);
+    runLoggedTicks(scheduler, 8);
+    for (uint8_t i = 0; i < 5; ++i)
+        TEST_ASSERT_EQUAL_UINT16(Phased::getPhase(i), log_first[i]);
+}
+
+void test_mixed_intervals(void)
+{
+    // every task on its phase, at its interval, over two periods of the longest; interval 0 never runs
+    using Mixed = StaticScheduler<
+        SchedulerClock,
+        StaticTask<logTask<0>, McpIndex::Motor, 1>,
+        StaticTask<logTask<1>, McpIndex::Bms, 2>,
+        StaticTask<logTask<2>, McpIndex::Motor, 3>,
+        StaticTask<logTask<3>, McpIndex::Datalogger, 6>,
+        StaticTask<logTask<4>, McpIndex::Motor, 0>>;
+    Mixed scheduler(SchedulerClock(PERIOD_US, 0, simMicros));
+    scheduler.synchronize(simMicros);
+    runLoggedTicks(scheduler, 12);
+
+    const uint16_t intervals[4] = {1, 2, 3, 6};
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        TEST_ASSERT_EQUAL_UINT16(12 / intervals[i], log_runs[i]);
+        TEST_ASSERT_EQUAL_UINT16(Mixed::getPhase(i), log_first[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT16(0, log_runs[4]);
+}
+
+void test_dynamic_auto_phase(void)
+{
+    Scheduler<2, 2> scheduler(PERIOD_US, 0, simMicros);
+    TEST_ASSERT_TRUE(scheduler.addTask(McpIndex::Motor, logTask<0>, 2, TASK_AUTO_PHASE));
+    TEST_ASSERT_TRUE(scheduler.addTask(McpIndex::Motor, logTask<1>, 4, TASK_AUTO_PHASE));
+    TEST_ASSERT_TRUE(scheduler.addTask(McpIndex::Bms, logTask<2>, 4, TASK_AUTO_PHASE));
+    TEST_ASSERT_TRUE(scheduler.addTask(McpIndex::Bms, logTask<3>, 0));
+    runLoggedTicks(scheduler, 8);
+
+    TEST_ASSERT_EQUAL_UINT16(0, log_first[0]);
+    TEST_ASSERT_EQUAL_UINT16(1, log_first[1]); // off the ticks of the first task
+    TEST_ASSERT_EQUAL_UINT16(3, log_first[2]); // off both
+    TEST_ASSERT_EQUAL_UINT16(4, log_runs[0]);
+    TEST_ASSERT_EQUAL_UINT16(2, log_runs[1]);
+    TEST_ASSERT_EQUAL_UINT16(2, log_runs[2]);
+    TEST_ASSERT_EQUAL_UINT16(1, log_runs[3]); // interval 0 runs once, not repeating
+}
+
+void test_stats_counters(void)
+{
+    SchedulerStats<2> stats;
+    stats.task(0, 100);
+    stats.task(0, 300);
+    stats.task(1, 70000); // saturates
+    stats.tick(500, 2000, PERIOD_US);
+    stats.tick(1500, 9000, PERIOD_US); // runs into the next tick
+
+    uint8_t frame[SCHEDULER_STATS_FRAME_BYTES];
+    stats.nextFrame(frame);
+    TEST_ASSERT_EQUAL_UINT8(0, frame[0]);
+    TEST_ASSERT_EQUAL_UINT8(2, frame[1]);
+    TEST_ASSERT_EQUAL_UINT16(100, frameField(frame, 2));
+    TEST_ASSERT_EQUAL_UINT16(300, frameField(frame, 4));
+    TEST_ASSERT_EQUAL_UINT16(200, frameField(frame, 6));
+
+    stats.nextFrame(frame);
+    TEST_ASSERT_EQUAL_UINT8(1, frame[0]);
+    TEST_ASSERT_EQUAL_UINT8(1, frame[1]);
+    TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, frameField(frame, 4));
+
+    stats.nextFrame(frame);
+    TEST_ASSERT_EQUAL_UINT8(SCHEDULER_STATS_TICK_FRAME, frame[0]);
+    TEST_ASSERT_EQUAL_UINT8(1, frame[1]);
+    TEST_ASSERT_EQUAL_UINT16(1500, frameField(frame, 2));
+    TEST_ASSERT_EQUAL_UINT16(1000, frameField(frame, 4));
+    TEST_ASSERT_EQUAL_UINT16(9000, frameField(frame, 6));
+
+    // every frame resets what it sent
+    stats.nextFrame(frame);
+    TEST_ASSERT_EQUAL_UINT8(0, frame[0]);
+    TEST_ASSERT_EQUAL_UINT8(0, frame[1]);
+    TEST_ASSERT_EQUAL_UINT16(0, frameField(frame, 2));
+    TEST_ASSERT_EQUAL_UINT16(0, frameField(frame, 4));
+}
+
+void test_table_order_without_priorities(void)
+{
+    // all Normal, torque last in the table, no budget: the torque command waits for everything before it
+    StaticScheduler<
+        SchedulerClock,
+        StaticTask<telemetryTask, McpIndex::Datalogger, 1>,
+        StaticTask<housekeepTask, McpIndex::Bms, 5>,
+        StaticTask<torqueTask, McpIndex::Motor, 1>>
+        scheduler(SchedulerClock(PERIOD_US, 0, simMicros));
+    runTicks(scheduler);
+
+    TEST_ASSERT_EQUAL_UINT16(SIM_TICKS, lateTorqueCount());
+    TEST_ASSERT_EQUAL_UINT16(0, scheduler.getDeferred());
+    TEST_ASSERT_EQUAL_UINT16(0, scheduler.getDropped());
+}
+
+void test_critical_task_stays_on_time(void)
+{
+    // same table, torque critical and telemetry low priority, with a budget
+    StaticScheduler<
+        SchedulerClock,
+        LowPriorityTask<telemetryTask, McpIndex::Datalogger>,
+        StaticTask<housekeepTask, McpIndex::Bms, 5>,
+        CriticalTask<torqueTask, McpIndex::Motor>>
+        scheduler(SchedulerClock(PERIOD_US, 0, simMicros), BUDGET_US);
+    runTicks(scheduler);
+
+    // only the tick right after each overrun starts late, shedding that tick catches up with the next one
+    const uint16_t overruns = telemetry_runs / OVERRUN_EVERY;
+    TEST_ASSERT_GREATER_THAN(0, overruns);
+    TEST_ASSERT_EQUAL_UINT16(overruns, lateTorqueCount());
+    for (uint16_t i = 1; i < SIM_TICKS; ++i)
+    {
+        if (torque_late[i - 1] > POLL_US)
+            TEST_ASSERT_LESS_OR_EQUAL(POLL_US, torque_late[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT16(overruns, scheduler.getDropped());
+}
+
+void test_normal_task_deferred_not_lost(void)
+{
+    // housekeeping only runs every 5 ticks, when its tick is over budget it must run on the next one instead
+    StaticScheduler<
+        SchedulerClock,
+        LowPriorityTask<telemetryTask, McpIndex::Datalogger>,
+        StaticTask<housekeepTask, McpIndex::Bms, 5, false, 0>,
+        CriticalTask<torqueTask, McpIndex::Motor>>
+        scheduler(SchedulerClock(PERIOD_US, 0, simMicros), BUDGET_US);
+    runTicks(scheduler);
+
+    // overruns are on ticks 9, 20, 31, ..., the late ticks after them land on every phase of housekeeping in turn
+    TEST_ASSERT_GREATER_THAN(0, scheduler.getDeferred());
+    TEST_ASSERT_EQUAL_UINT16(SIM_TICKS / 5, housekeep_runs);
+}
+
+void test_timer_clock_overrun_sheds(void)
+{
+    // Timer1 restarts on every match, the match during the overrun must count as a period of lateness
+    StaticScheduler<
+        TimerClock,
+        CriticalTask<timerTorqueTask, McpIndex::Motor>,
+        LowPriorityTask<telemetryTask, McpIndex::Datalogger>>
+        scheduler(TimerClock(PERIOD_US, nullptr), BUDGET_US);
+    TEST_ASSERT_TRUE(scheduler.begin());
+    scheduler.synchronize(simMicros);
+    while (torque_runs < SIM_TICKS)
+    {
+        TimerClock::handleInterrupt();
+        scheduler.update();
+        scheduler.update(); // the tick that came due during an overrun, on time again
+    }
+
+    const uint16_t overruns = SIM_TICKS / OVERRUN_EVERY;
+    TEST_ASSERT_EQUAL_UINT16(overruns, scheduler.getDropped());
+    TEST_ASSERT_EQUAL_UINT16(torque_runs - overruns, telemetry_runs);
+}
+
+void test_multi_rate_base_tick(void)
+{
+    using TorqueAndHousekeeping = StaticScheduler<
+        SchedulerClock,
+        RateTask<countTask<0>, McpIndex::Motor, 1000>,
+        RateTask<countTask<1>, McpIndex::Bms, 1000000>>;
+    TEST_ASSERT_EQUAL_UINT32(1000, TorqueAndHousekeeping::BASE_PERIOD_US);
+
+    using Uneven = StaticScheduler<
+        SchedulerClock,
+        RateTask<countTask<0>, McpIndex::Motor, 4000>,
+        RateTask<countTask<1>, McpIndex::Bms, 6000>,
+        RateTask<countTask<2>, McpIndex::Datalogger, 0>>; // left out
+    TEST_ASSERT_EQUAL_UINT32(2000, Uneven::BASE_PERIOD_US);
+
+    using Ticks = StaticScheduler<SchedulerClock, StaticTask<countTask<0>, McpIndex::Motor, 1>>;
+    TEST_ASSERT_EQUAL_UINT32(0, Ticks::BASE_PERIOD_US);
+
+    // the clock has to tick at the base period
+    TorqueAndHousekeeping wrong_clock(SchedulerClock(PERIOD_US, 0, simMicros));
+    TEST_ASSERT_FALSE(wrong_clock.begin());
+    TorqueAndHousekeeping right_clock(SchedulerClock(TorqueAndHousekeeping::BASE_PERIOD_US, 0, simMicros));
+    TEST_ASSERT_TRUE(right_clock.begin());
+}
+
+void test_multi_rate_periods(void)
+{
+    // 1 ms torque loop, 10 ms telemetry and 1 s housekeeping: 1000 ticks between housekeeping runs, past uint8_t
+    using MultiRate = StaticScheduler<
+        SchedulerClock,
+        RateTask<countTask<0>, McpIndex::Motor, 1000, false, TaskPriority::Critical>,
+        RateTask<countTask<1>, McpIndex::Datalogger, 10000, false, TaskPriority::Low>,
+        RateTask<countTask<2>, McpIndex::Bms, 1000000>>;
+    MultiRate scheduler(SchedulerClock(MultiRate::BASE_PERIOD_US, 0, simMicros));
+    TEST_ASSERT_TRUE(scheduler.begin());
+    scheduler.synchronize(simMicros);
+
+    const uint32_t end_us = sim_us + 3000000;
+    while (static_cast<int32_t>(end_us - sim_us) > 0)
+    {
+        scheduler.update();
+        sim_us += POLL_US;
+    }
+
+    TEST_ASSERT_UINT16_WITHIN(1, 3000, rate_runs[0]);
+    TEST_ASSERT_UINT16_WITHIN(1, 300, rate_runs[1]);
+    TEST_ASSERT_EQUAL_UINT16(3, rate_runs[2]);
+    // staggered off the ticks of the telemetry task
+    TEST_ASSERT_NOT_EQUAL(0, MultiRate::getPhase(2) % 10);
+}
+
+void test_dynamic_phase_range(void)
+{
+    Scheduler<2, 1> scheduler(PERIOD_US, 0, simMicros);
+    TEST_ASSERT_FALSE(scheduler.addTask(McpIndex::Motor, housekeepTask, 5, 0xFF)); // automatic before TASK_AUTO_PHASE widened
+    TEST_ASSERT_FALSE(scheduler.addTask(McpIndex::Motor, housekeepTask, 5, 5));
+    TEST_ASSERT_TRUE(scheduler.addTask(McpIndex::Motor, housekeepTask, 5, 4));
+    TEST_ASSERT_TRUE(scheduler.addTask(McpIndex::Motor, telemetryTask, 1, TASK_AUTO_PHASE));
+
+    // first run on tick 4, counted from 0
+    for (uint8_t tick = 0; tick < 10; ++tick)
+    {
+        sim_us += PERIOD_US;
+        scheduler.update();
+        TEST_ASSERT_EQUAL_UINT16(tick >= 4 ? (tick >= 9 ? 2 : 1) : 0, housekeep_runs);
+    }
+    TEST_ASSERT_EQUAL_UINT16(10, telemetry_runs);
+}
+
+int runUnityTests(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_dispatch_order);
+    RUN_TEST(test_static_phases);
+    RUN_TEST(test_mixed_intervals);
+    RUN_TEST(test_dynamic_auto_phase);
+    RUN_TEST(test_stats_counters);
+    RUN_TEST(test_table_order_without_priorities);
+    RUN_TEST(test_critical_task_stays_on_time);
+    RUN_TEST(test_normal_task_deferred_not_lost);
+    RUN_TEST(test_timer_clock_overrun_sheds);
+    RUN_TEST(test_multi_rate_base_tick);
+    RUN_TEST(test_multi_rate_periods);
+    RUN_TEST(test_dynamic_phase_range);
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup()
+{
+    runUnityTests();
+}
+
+void loop()
+{
+    // not used
+}
+#else
+int main(void)
+{
+    return runUnityTests();
+}
+#endif
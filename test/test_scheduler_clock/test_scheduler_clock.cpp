@@ -0,0 +1,248 @@
+/**
+ * @file test_scheduler_clock.cpp
+ * @author Planeson, Red Bird Racing
+ * @brief Host-side dispatch jitter of SchedulerClock and TimerClock on a simulated clock, run with `pio test -e native`
+ * @details A simulated loop() alternates between asking the clock for a tick, running the tasks and other work,
+ * and reports how far the interval between dispatched ticks strays from the period.
+ * The timer compare interrupt is simulated by calling TimerClock::handleInterrupt() once its time has passed.
+ * @version 1.0
+ * @date 2026-10-16
+ * @see SchedulerClock.hpp, TimerClock.hpp
+ */
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "SchedulerClock.hpp"
+#include "TimerClock.hpp"
+
+constexpr uint32_t PERIOD_US = 10000;         /**< Scheduler tick, SCHEDULER_PERIOD_US */
+constexpr uint32_t SPIN_US = 500;             /**< Spin-wait threshold of main.cpp before TimerClock */
+constexpr uint32_t MICROS_COST_US = 4;        /**< Each micros() call advances the time by its resolution */
+constexpr uint32_t TASKS_US = 1500;           /**< Time taken by the tasks of one tick */
+constexpr uint32_t BACKGROUND_MAX_US = 1000;  /**< Longest piece of background work in loop() between calls */
+constexpr uint32_t LOOP_BODY_MAX_US = 60;     /**< Longest rest of loop() when there is no background work */
+constexpr uint32_t WAKE_US = 2;               /**< Interrupt and wake-up latency out of SLEEP_MODE_IDLE */
+constexpr uint32_t OTHER_IRQ_US = 104;        /**< Other interrupts waking the CPU, one per ADC conversion */
+constexpr uint32_t SIM_TICKS = 2000;          /**< Ticks per simulation */
+
+uint32_t sim_us;       /**< Simulated time */
+uint32_t next_tick_us; /**< Next simulated timer compare match */
+uint32_t rng;          /**< State of the pseudo-random work lengths */
+
+/**
+ * @brief Pseudo-random number, the same sequence for every mode
+ * @param max Largest value
+ * @return Value in [0, max]
+ */
+uint32_t randomUpTo(const uint32_t max)
+{
+    rng = rng * 1664525UL + 1013904223UL;
+    return (rng >> 8) % (max + 1);
+}
+
+/**
+ * @brief micros() on the simulated time
+ * @return Simulated time, advanced by MICROS_COST_US
+ */
+unsigned long simMicros()
+{
+    sim_us += MICROS_COST_US;
+    return sim_us;
+}
+
+/**
+ * @brief Raises the timer interrupts that are due by now
+ */
+void simTimer()
+{
+    while (static_cast<int32_t>(sim_us - next_tick_us) >= 0)
+    {
+        TimerClock::handleInterrupt();
+        next_tick_us += PERIOD_US;
+    }
+}
+
+/**
+ * @brief Simulated TimerClock::sleepIdle, sleeps until the timer or another interrupt
+ */
+void simSleep()
+{
+    const uint32_t next_other_us = (sim_us / OTHER_IRQ_US + 1) * OTHER_IRQ_US;
+    const uint32_t wake_us = static_cast<int32_t>(next_tick_us - next_other_us) < 0 ? next_tick_us : next_other_us;
+    if (static_cast<int32_t>(wake_us - sim_us) > 0)
+        sim_us = wake_us;
+    sim_us += WAKE_US;
+    simTimer();
+}
+
+/**
+ * @brief Jitter of one simulation
+ */
+struct JitterStats
+{
+    uint32_t ticks;         /**< Ticks dispatched */
+    uint32_t worst_us;      /**< Worst |interval - PERIOD_US| */
+    uint32_t total_us;      /**< Sum of |interval - PERIOD_US| */
+    uint32_t background_us; /**< Time given to background work */
+};
+
+/**
+ * @brief Runs loop() for SIM_TICKS periods and measures the tick intervals
+ * @tparam CLOCK SchedulerClock or TimerClock
+ * @param clock Clock to ask for ticks
+ * @param background true to do background work when no tick is due, false for a short loop() body only
+ * @return Jitter of the dispatched ticks
+ */
+template <typename CLOCK>
+JitterStats runLoop(CLOCK &clock, const bool background)
+{
+    JitterStats stats = {0, 0, 0, 0};
+    uint32_t last_us = 0;
+    const uint32_t end_us = sim_us + SIM_TICKS * PERIOD_US;
+    while (static_cast<int32_t>(end_us - sim_us) > 0)
+    {
+        simTimer();
+        if (clock.due())
+        {
+            if (stats.ticks != 0)
+            {
+                const uint32_t interval = sim_us - last_us;
+                const uint32_t error = interval > PERIOD_US ? interval - PERIOD_US : PERIOD_US - interval;
+                if (error > stats.worst_us)
+                    stats.worst_us = error;
+                stats.total_us += error;
+            }
+            last_us = sim_us;
+            ++stats.ticks;
+            sim_us += TASKS_US;
+        }
+        else if (background)
+        {
+            const uint32_t work = randomUpTo(BACKGROUND_MAX_US);
+            sim_us += work;
+            stats.background_us += work;
+        }
+        else
+        {
+            sim_us += randomUpTo(LOOP_BODY_MAX_US);
+        }
+    }
+    return stats;
+}
+
+/**
+ * @brief Prints the jitter of one mode
+ * @param name Mode
+ * @param stats Its jitter
+ */
+void reportJitter(const char *name, const JitterStats &stats)
+{
+    char msg[120];
+    snprintf(msg, sizeof(msg), "%s: %lu ticks, jitter worst %lu us, mean %lu us, background %lu%%", name,
+             static_cast<unsigned long>(stats.ticks), static_cast<unsigned long>(stats.worst_us),
+             static_cast<unsigned long>(stats.total_us / (stats.ticks - 1)),
+             static_cast<unsigned long>(stats.background_us / (SIM_TICKS * PERIOD_US / 100)));
+    TEST_MESSAGE(msg);
+}
+
+void setUp(void)
+{
+    // runs before each test
+    sim_us = 1000;
+    next_tick_us = sim_us + PERIOD_US;
+    rng = 12345;
+}
+
+void tearDown(void)
+{
+    // runs after each test
+    // optional in the sense that this can be empty
+    // to ensure it compiles on all platforms, do not remove this empty function
+}
+
+void test_spin_wait_jitter(void)
+{
+    SchedulerClock clock(PERIOD_US, SPIN_US, simMicros);
+    clock.synchronize(simMicros);
+    const JitterStats stats = runLoop(clock, true);
+    reportJitter("SchedulerClock, spin-wait", stats);
+    TEST_ASSERT_UINT32_WITHIN(1, SIM_TICKS, stats.ticks);
+    // background work started just before the spin window delays the tick by up to its length
+    TEST_ASSERT_LESS_OR_EQUAL(2 * (BACKGROUND_MAX_US - SPIN_US + MICROS_COST_US), stats.worst_us);
+}
+
+void test_timer_background_jitter(void)
+{
+    TimerClock clock(PERIOD_US, nullptr);
+    clock.synchronize(nullptr);
+    const JitterStats stats = runLoop(clock, true);
+    reportJitter("TimerClock, background work", stats);
+    TEST_ASSERT_UINT32_WITHIN(1, SIM_TICKS, stats.ticks);
+    TEST_ASSERT_LESS_OR_EQUAL(2 * BACKGROUND_MAX_US, stats.worst_us);
+
+    // no time is spent spinning, so more is left for background work than with SchedulerClock
+    setUp();
+    SchedulerClock spin_clock(PERIOD_US, SPIN_US, simMicros);
+    spin_clock.synchronize(simMicros);
+    TEST_ASSERT_GREATER_THAN(runLoop(spin_clock, true).background_us, stats.background_us);
+}
+
+void test_timer_sleep_jitter(void)
+{
+    TimerClock clock(PERIOD_US, simSleep);
+    clock.synchronize(nullptr);
+    const JitterStats stats = runLoop(clock, false);
+    reportJitter("TimerClock, SLEEP_MODE_IDLE", stats);
+    TEST_ASSERT_UINT32_WITHIN(1, SIM_TICKS, stats.ticks);
+    // woken by the timer, or by another interrupt with at most one loop() body before the tick is seen
+    TEST_ASSERT_LESS_OR_EQUAL(2 * (LOOP_BODY_MAX_US + WAKE_US), stats.worst_us);
+}
+
+void test_timer_missed_ticks(void)
+{
+    TimerClock clock(PERIOD_US, nullptr);
+    clock.synchronize(nullptr);
+    TEST_ASSERT_FALSE(clock.due());
+    TimerClock::handleInterrupt();
+    TEST_ASSERT_TRUE(clock.due());
+    TEST_ASSERT_FALSE(clock.due());
+
+    // tasks overran three periods: one tick, not a burst of three
+    TimerClock::handleInterrupt();
+    TimerClock::handleInterrupt();
+    TimerClock::handleInterrupt();
+    TEST_ASSERT_TRUE(clock.due());
+    TEST_ASSERT_FALSE(clock.due());
+
+    // synchronize drops a pending tick
+    TimerClock::handleInterrupt();
+    clock.synchronize(nullptr);
+    TEST_ASSERT_FALSE(clock.due());
+}
+
+int runUnityTests(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_spin_wait_jitter);
+    RUN_TEST(test_timer_background_jitter);
+    RUN_TEST(test_timer_sleep_jitter);
+    RUN_TEST(test_timer_missed_ticks);
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup()
+{
+    runUnityTests();
+}
+
+void loop()
+{
+    // not used
+}
+#else
+int main(void)
+{
+    return runUnityTests();
+}
+#endif
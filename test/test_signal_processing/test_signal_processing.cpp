@@ -0,0 +1,473 @@
+/**
+ * @file test_signal_processing.cpp
+ * @author Planeson, Red Bird Racing
+ * @brief Host-side tests for the filters in SignalProcessing.hpp, run with `pio test -e native`
+ * @version 1.7
+ * @date 2026-10-16
+ * @see SignalProcessing.hpp
+ */
+#include <unity.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+#include "SignalProcessing.hpp"
+
+// static interface: no vptr, a filter is exactly its state
+static_assert(sizeof(ExponentialFilter<uint16_t, uint16_t>) == sizeof(uint16_t), "ExponentialFilter must not carry a vptr");
+static_assert(sizeof(PreciseExponentialFilter<uint16_t>) == sizeof(uint32_t), "PreciseExponentialFilter must not carry a vptr");
+static_assert(sizeof(AverageFilter<uint16_t, uint32_t, 4>) == 4 * sizeof(uint16_t) + sizeof(uint32_t) + 2 * sizeof(uint16_t), "AverageFilter must not carry a vptr");
+static_assert(sizeof(FilterChain<AverageFilter<uint16_t, uint16_t, 4>, ExponentialFilter<uint16_t, uint16_t>>) ==
+                  sizeof(AverageFilter<uint16_t, uint16_t, 4>) + sizeof(ExponentialFilter<uint16_t, uint16_t>),
+              "FilterChain must cost only its stages"); // 16-bit stages, so host alignment adds no padding
+static_assert(sizeof(FilterChain<MedianFilter<uint8_t, 3>, ExponentialFilter<uint32_t, uint32_t>>::Output) == sizeof(uint32_t) &&
+                  static_cast<FilterChain<MedianFilter<uint16_t, 3>, BiquadFilter<int16_t>>::Output>(-1) < 0,
+              "FilterChain must give the last stage's output type");
+
+/**
+ * @brief Feeds the same sample into any filter through the static interface
+ * @param filter The filter
+ * @param sample Sample to add
+ * @param count Number of times to add it
+ * @return Filtered value after the last sample
+ */
+template <typename Derived, typename TypeInput>
+TypeInput feed(Filter<Derived, TypeInput> &filter, const TypeInput sample, const uint16_t count)
+{
+    for (uint16_t i = 0; i < count; ++i)
+        filter.addSample(sample);
+    return filter.getFiltered();
+}
+
+/**
+ * @brief Reference exponential filter, the formula from the ExponentialFilter documentation
+ * @param last Previous output
+ * @param sample New sample
+ * @return New output
+ */
+uint16_t referenceExponential(const uint16_t last, const uint16_t sample)
+{
+    return static_cast<uint16_t>((static_cast<uint32_t>(last) * 31 + sample + 16) / 32);
+}
+
+/**
+ * @brief Naive moving average, sums the last min(count, size) samples and divides
+ * @param history All samples so far, oldest first
+ * @param count Number of samples so far
+ * @param size Window size
+ * @return Average rounded down, 0 before the first sample
+ */
+uint16_t referenceAverage(const uint16_t *history, const uint16_t count, const uint16_t size)
+{
+    const uint16_t window = count < size ? count : size;
+    if (window == 0)
+        return 0;
+    uint32_t sum = 0;
+    for (uint16_t i = count - window; i < count; ++i)
+        sum += history[i];
+    return static_cast<uint16_t>(sum / window);
+}
+
+/**
+ * @brief Feeds random samples into an AverageFilter and compares every output with referenceAverage
+ * @tparam SIZE Window size of the filter
+ * @param max_sample Samples are drawn from [0, max_sample]
+ */
+template <uint16_t SIZE>
+void checkAverageRandom(const uint16_t max_sample)
+{
+    constexpr uint16_t SAMPLES = 2000;
+    static uint16_t history[SAMPLES];
+    AverageFilter<uint16_t, uint32_t, SIZE> filter;
+    TEST_ASSERT_EQUAL_UINT16(0, filter.getFiltered());
+    for (uint16_t i = 0; i < SAMPLES; ++i)
+    {
+        history[i] = static_cast<uint16_t>(rand() % (static_cast<uint32_t>(max_sample) + 1));
+        filter.addSample(history[i]);
+        TEST_ASSERT_EQUAL_UINT16(referenceAverage(history, i + 1, SIZE), filter.getFiltered());
+    }
+}
+
+/**
+ * @brief Feeds random samples into a PreciseExponentialFilter and compares it with the exponential average in double
+ * @tparam OLD_RATIO Weighting ratio for the old value
+ * @tparam NEW_RATIO Weighting ratio for the new sample
+ * @param max_sample Samples are drawn from [0, max_sample]
+ */
+template <uint8_t OLD_RATIO, uint8_t NEW_RATIO>
+void checkPreciseExponentialRandom(const uint16_t max_sample)
+{
+    PreciseExponentialFilter<uint16_t, uint32_t, OLD_RATIO, NEW_RATIO> filter;
+    double expected = 0;
+    for (uint16_t i = 0; i < 2000; ++i)
+    {
+        const uint16_t sample = static_cast<uint16_t>(rand() % (static_cast<uint32_t>(max_sample) + 1));
+        filter.addSample(sample);
+        expected = (expected * OLD_RATIO + static_cast<double>(sample) * NEW_RATIO) / (OLD_RATIO + NEW_RATIO);
+        // truncation error stays within a few LSB of the 16 fractional bits
+        TEST_ASSERT_DOUBLE_WITHIN(0.002, expected, filter.getFilteredPrecise() / 65536.0);
+        TEST_ASSERT_DOUBLE_WITHIN(0.502, expected, filter.getFiltered());
+    }
+}
+
+/**
+ * @brief Feeds random samples into a MedianFilter and compares every output with the middle of a sorted copy of the window
+ * @tparam TypeInput Type of the input samples
+ * @tparam SIZE Number of taps
+ * @param min_sample Samples are drawn from [min_sample, min_sample + span]
+ * @param span Range of the samples
+ */
+template <typename TypeInput, uint8_t SIZE>
+void checkMedianRandom(const int32_t min_sample, const uint32_t span)
+{
+    MedianFilter<TypeInput, SIZE> filter;
+    TypeInput window[SIZE];
+    for (uint16_t i = 0; i < 2000; ++i)
+    {
+        const TypeInput sample = static_cast<TypeInput>(min_sample + static_cast<int32_t>(rand() % (span + 1)));
+        if (i == 0)
+            for (TypeInput &value : window)
+                value = sample;
+        for (uint8_t j = 0; j + 1 < SIZE; ++j)
+            window[j] = window[j + 1];
+        window[SIZE - 1] = sample;
+        TypeInput sorted[SIZE];
+        for (uint8_t j = 0; j < SIZE; ++j)
+            sorted[j] = window[j];
+        for (uint8_t j = 1; j < SIZE; ++j) // insertion sort
+            for (uint8_t k = j; k > 0 && sorted[k] < sorted[k - 1]; --k)
+            {
+                const TypeInput t = sorted[k];
+                sorted[k] = sorted[k - 1];
+                sorted[k - 1] = t;
+            }
+        filter.addSample(sample);
+        TEST_ASSERT_EQUAL_INT32(sorted[SIZE / 2], filter.getFiltered());
+    }
+}
+
+/**
+ * @brief Magnitude response of a biquad from its fixed point coefficients
+ * @tparam TypeCoeff Signed type of the coefficients
+ * @param c Coefficients
+ * @param w Normalized angular frequency, 2 pi f / fs
+ * @return |H(e^jw)|
+ */
+template <typename TypeCoeff>
+double biquadGain(const BiquadCoefficients<TypeCoeff> &c, const double w)
+{
+    const double scale = static_cast<double>(static_cast<uint32_t>(1) << BiquadCoefficients<TypeCoeff>::FRACTION_BITS);
+    const double num_re = (c.b0 + c.b1 * cos(w) + c.b2 * cos(2 * w)) / scale;
+    const double num_im = -(c.b1 * sin(w) + c.b2 * sin(2 * w)) / scale;
+    const double den_re = 1 + (c.a1 * cos(w) + c.a2 * cos(2 * w)) / scale;
+    const double den_im = -(c.a1 * sin(w) + c.a2 * sin(2 * w)) / scale;
+    return sqrt((num_re * num_re + num_im * num_im) / (den_re * den_re + den_im * den_im));
+}
+
+/**
+ * @brief Feeds a sine into a biquad and measures the amplitude of the output at that frequency after settling
+ * @tparam Biquad BiquadFilter type
+ * @param filter The filter
+ * @param frequency Frequency of the sine, as a fraction of the sample rate
+ * @return Measured gain, output amplitude over input amplitude
+ */
+template <typename Biquad>
+double measureGain(Biquad &filter, const double frequency)
+{
+    constexpr double OFFSET = 512;
+    constexpr double AMPLITUDE = 250; // peak gain of the resonant filter is 2, must not clip
+    constexpr uint16_t SETTLE = 500;
+    constexpr uint16_t MEASURE = 1000; // whole periods for every frequency checked
+    double re = 0;
+    double im = 0;
+    for (uint16_t i = 0; i < SETTLE + MEASURE; ++i)
+    {
+        const double phase = 2 * M_PI * frequency * i;
+        filter.addSample(static_cast<uint16_t>(lround(OFFSET + AMPLITUDE * sin(phase))));
+        if (i < SETTLE)
+            continue;
+        // single bin DFT at the input frequency
+        re += filter.getFiltered() * cos(phase);
+        im += filter.getFiltered() * sin(phase);
+    }
+    return 2 * sqrt(re * re + im * im) / MEASURE / AMPLITUDE;
+}
+
+/**
+ * @brief Checks the measured gain of a biquad against its designed response over the band
+ * @tparam Biquad BiquadFilter type
+ * @tparam TypeCoeff Signed type of the coefficients
+ * @param coeffs Coefficients of the filter
+ */
+template <typename Biquad, typename TypeCoeff>
+void checkFrequencyResponse(const BiquadCoefficients<TypeCoeff> &coeffs)
+{
+    const double frequencies[] = {0.01, 0.05, 0.1, 0.15, 0.2, 0.3, 0.4};
+    for (const double frequency : frequencies)
+    {
+        Biquad filter(coeffs);
+        // rounding of the input and output, a fraction of a count of 250
+        TEST_ASSERT_DOUBLE_WITHIN(0.004, biquadGain(coeffs, 2 * M_PI * frequency), measureGain(filter, frequency));
+    }
+}
+
+void setUp(void)
+{
+    // runs before each test
+    // optional in the sense that this can be empty
+    // to ensure it compiles on all platforms, do not remove this empty function
+}
+
+void tearDown(void)
+{
+    // runs after each test
+    // optional in the sense that this can be empty
+    // to ensure it compiles on all platforms, do not remove this empty function
+}
+
+void test_exponential_matches_formula(void)
+{
+    ExponentialFilter<uint16_t, uint32_t> filter;
+    uint16_t expected = 0;
+    for (uint16_t i = 0; i < 500; ++i)
+    {
+        const uint16_t sample = (i / 50) % 2 ? 1023 : 100; // square wave
+        filter.addSample(sample);
+        expected = referenceExponential(expected, sample);
+        TEST_ASSERT_EQUAL_UINT16(expected, filter.getFiltered());
+    }
+}
+
+void test_average_settles(void)
+{
+    AverageFilter<uint16_t, uint32_t, 4> filter;
+    TEST_ASSERT_EQUAL_UINT16(0, filter.getFiltered());
+    TEST_ASSERT_EQUAL_UINT16(600, feed(filter, static_cast<uint16_t>(600), 4));
+    filter.addSample(200);
+    TEST_ASSERT_EQUAL_UINT16(500, filter.getFiltered());
+}
+
+void test_chain_matches_stages(void)
+{
+    FilterChain<AverageFilter<uint16_t, uint32_t, 4>, ExponentialFilter<uint16_t, uint32_t>> chain;
+    AverageFilter<uint16_t, uint32_t, 4> average;
+    ExponentialFilter<uint16_t, uint32_t> exponential;
+    for (uint16_t i = 0; i < 300; ++i)
+    {
+        const uint16_t sample = static_cast<uint16_t>((i * 37) % 1024);
+        chain.addSample(sample);
+        average.addSample(sample);
+        exponential.addSample(average.getFiltered());
+        TEST_ASSERT_EQUAL_UINT16(exponential.getFiltered(), chain.getFiltered());
+        TEST_ASSERT_EQUAL_UINT16(average.getFiltered(), chain.first().getFiltered());
+    }
+}
+
+void test_average_matches_naive_sum(void)
+{
+    srand(12345); // fixed seed, failures are reproducible
+    checkAverageRandom<1>(1023);
+    checkAverageRandom<16>(1023);
+    checkAverageRandom<32>(1023);
+    checkAverageRandom<10>(1023);
+    checkAverageRandom<7>(0xFFFF);
+    checkAverageRandom<64>(0xFFFF);
+}
+
+void test_average_signed_rounds_toward_zero(void)
+{
+    // a shift would round -1 / 4 down to -1, the divide gives 0
+    AverageFilter<int16_t, int32_t, 4> filter;
+    filter.addSample(-1);
+    TEST_ASSERT_EQUAL_INT16(0, feed(filter, static_cast<int16_t>(0), 3));
+    TEST_ASSERT_EQUAL_INT16(-2, feed(filter, static_cast<int16_t>(-3), 3)); // -9 / 4
+}
+
+void test_precise_exponential_settles(void)
+{
+    // ExponentialFilter gets stuck (OLD_RATIO + NEW_RATIO) / 2 below a step up, the precise one doesn't
+    ExponentialFilter<uint16_t, uint16_t> coarse;
+    TEST_ASSERT_LESS_THAN(1023, feed(coarse, static_cast<uint16_t>(1023), 1000));
+
+    PreciseExponentialFilter<uint16_t> filter;
+    TEST_ASSERT_EQUAL_UINT16(1023, feed(filter, static_cast<uint16_t>(1023), 1000));
+    TEST_ASSERT_EQUAL_UINT16(1, feed(filter, static_cast<uint16_t>(1), 1000));
+    TEST_ASSERT_EQUAL_UINT16(0xFFFF, feed(filter, static_cast<uint16_t>(0xFFFF), 1000));
+    TEST_ASSERT_EQUAL_UINT16(0, feed(filter, static_cast<uint16_t>(0), 1000));
+    TEST_ASSERT_LESS_THAN(32, filter.getFilteredPrecise()); // stops within 2^-11 LSB of a step down
+
+    PreciseExponentialFilter<uint16_t, uint32_t, 6, 1> divided;
+    TEST_ASSERT_EQUAL_UINT16(1023, feed(divided, static_cast<uint16_t>(1023), 1000));
+    TEST_ASSERT_EQUAL_UINT16(7, feed(divided, static_cast<uint16_t>(7), 1000));
+}
+
+void test_precise_exponential_matches_reference(void)
+{
+    srand(54321);
+    checkPreciseExponentialRandom<31, 1>(1023);  // shift-only
+    checkPreciseExponentialRandom<3, 1>(0xFFFF); // shift-only, full 16.16 range
+    checkPreciseExponentialRandom<12, 4>(1023);  // shift-only, NEW_RATIO > 1
+    checkPreciseExponentialRandom<6, 1>(0xFFFF); // divide fallback
+}
+
+void test_median_matches_sort(void)
+{
+    srand(2468);
+    checkMedianRandom<uint16_t, 3>(0, 1023);
+    checkMedianRandom<uint16_t, 5>(0, 1023);
+    checkMedianRandom<uint16_t, 5>(0, 0xFFFF);
+    checkMedianRandom<int16_t, 3>(-32768, 0xFFFF);
+    checkMedianRandom<int16_t, 5>(-32768, 0xFFFF);
+    checkMedianRandom<uint8_t, 5>(0, 3); // many equal samples
+}
+
+void test_median_rejects_spikes(void)
+{
+    MedianFilter<uint16_t, 3> median3;
+    MedianFilter<uint16_t, 5> median5;
+    // first sample fills the window, no ramp up from 0
+    TEST_ASSERT_EQUAL_UINT16(400, feed(median3, static_cast<uint16_t>(400), 1));
+    TEST_ASSERT_EQUAL_UINT16(400, feed(median5, static_cast<uint16_t>(400), 1));
+    for (uint16_t i = 0; i < 100; ++i)
+    {
+        const uint16_t sample = (i % 10 == 3) ? 1023 : ((i % 10 == 7) ? 0 : 400); // single spikes both ways
+        median3.addSample(sample);
+        TEST_ASSERT_EQUAL_UINT16(400, median3.getFiltered());
+        median5.addSample((i % 10 == 3 || i % 10 == 4) ? 1023 : 400); // double spikes
+        TEST_ASSERT_EQUAL_UINT16(400, median5.getFiltered());
+    }
+    // a real step gets through after SIZE / 2 samples
+    median3.addSample(800);
+    TEST_ASSERT_EQUAL_UINT16(400, median3.getFiltered());
+    median3.addSample(800);
+    TEST_ASSERT_EQUAL_UINT16(800, median3.getFiltered());
+}
+
+void test_filter_bank_matches_chains(void)
+{
+    // same channels as Pedal's input_filters
+    FilterBank<3, 5, 5, 5, 3> bank;
+    FilterChain<MedianFilter<uint16_t, 3>, PreciseExponentialFilter<uint16_t, uint32_t, 31, 1>> pedal_chains[3];
+    FilterChain<MedianFilter<uint16_t, 3>, PreciseExponentialFilter<uint16_t, uint32_t, 7, 1>> hall_chain;
+    FilterBank<5, 0, 4> bank5; // pass-through and 5 taps
+    MedianFilter<uint16_t, 5> median5;
+    FilterChain<MedianFilter<uint16_t, 5>, PreciseExponentialFilter<uint16_t, uint32_t, 15, 1>> chain5;
+    srand(97531);
+    for (uint16_t i = 0; i < 2000; ++i)
+    {
+        uint16_t samples[4];
+        for (uint16_t &sample : samples)
+            sample = static_cast<uint16_t>(rand() % 1024);
+        bank.addSamples(samples);
+        uint16_t snapshot[4];
+        bank.snapshot(snapshot);
+        for (uint8_t c = 0; c < 3; ++c)
+        {
+            pedal_chains[c].addSample(samples[c]);
+            TEST_ASSERT_EQUAL_UINT16(pedal_chains[c].first().getFiltered(), bank.getMedian(c));
+            TEST_ASSERT_EQUAL_UINT16(pedal_chains[c].getFiltered(), bank.getFiltered(c));
+            TEST_ASSERT_EQUAL_UINT16(pedal_chains[c].getFiltered(), snapshot[c]);
+        }
+        hall_chain.addSample(samples[3]);
+        TEST_ASSERT_EQUAL_UINT16(hall_chain.getFiltered(), snapshot[3]);
+
+        const uint16_t samples5[2] = {samples[0], static_cast<uint16_t>(samples[1] * 64)};
+        bank5.addSamples(samples5);
+        median5.addSample(samples5[0]);
+        chain5.addSample(samples5[1]);
+        TEST_ASSERT_EQUAL_UINT16(median5.getFiltered(), bank5.getFiltered(0));
+        TEST_ASSERT_EQUAL_UINT16(chain5.getFiltered(), bank5.getFiltered(1));
+    }
+}
+
+void test_biquad_design(void)
+{
+    // 10Hz Butterworth at the 10ms scheduler period, against the cookbook formulas in double
+    constexpr BiquadCoefficients<int16_t> q14 = biquadLowPass<int16_t>(10, 0.7071, 10000);
+    constexpr BiquadCoefficients<int32_t> q30 = biquadLowPass<int32_t>(10, 0.7071, 10000);
+    const double w0 = 2 * M_PI * 10 / 100;
+    const double alpha = sin(w0) / (2 * 0.7071);
+    const double a0 = 1 + alpha;
+    TEST_ASSERT_INT_WITHIN(1, lround((1 - cos(w0)) / 2 / a0 * 16384), q14.b0);
+    TEST_ASSERT_INT_WITHIN(2, lround((1 - cos(w0)) / a0 * 16384), q14.b1); // adjusted for exact DC gain
+    TEST_ASSERT_INT_WITHIN(1, lround(-2 * cos(w0) / a0 * 16384), q14.a1);
+    TEST_ASSERT_INT_WITHIN(1, lround((1 - alpha) / a0 * 16384), q14.a2);
+    TEST_ASSERT_EQUAL_INT32(q14.b0, q14.b2);
+    TEST_ASSERT_EQUAL_INT32(16384 + q14.a1 + q14.a2, q14.b0 + q14.b1 + q14.b2);
+    TEST_ASSERT_INT32_WITHIN(64, llround(-2 * cos(w0) / a0 * 1073741824.0), q30.a1);
+    TEST_ASSERT_INT32_WITHIN(64, llround((1 - alpha) / a0 * 1073741824.0), q30.a2);
+    // -3dB at the cutoff
+    TEST_ASSERT_DOUBLE_WITHIN(0.01, 0.7071, biquadGain(q14, w0));
+}
+
+void test_biquad_frequency_response(void)
+{
+    constexpr BiquadCoefficients<int16_t> butterworth = biquadLowPass<int16_t>(10, 0.7071, 10000);
+    constexpr BiquadCoefficients<int16_t> resonant = biquadLowPass<int16_t>(20, 2, 10000);
+    constexpr BiquadCoefficients<int32_t> precise = biquadLowPass<int32_t>(10, 0.7071, 10000);
+    checkFrequencyResponse<BiquadFilter<uint16_t>>(butterworth);
+    checkFrequencyResponse<BiquadFilter<uint16_t, int16_t, int32_t, BiquadForm::DirectForm2Transposed>>(butterworth);
+    checkFrequencyResponse<BiquadFilter<uint16_t>>(resonant);
+    checkFrequencyResponse<BiquadFilter<uint16_t, int32_t, int64_t>>(precise);
+}
+
+void test_biquad_settles_and_saturates(void)
+{
+    constexpr BiquadCoefficients<int16_t> butterworth = biquadLowPass<int16_t>(10, 0.7071, 10000);
+    BiquadFilter<uint16_t> df1(butterworth);
+    BiquadFilter<uint16_t, int16_t, int32_t, BiquadForm::DirectForm2Transposed> df2(butterworth);
+    // exact DC gain and no rounding bias, both ways
+    TEST_ASSERT_EQUAL_UINT16(1023, feed(df1, static_cast<uint16_t>(1023), 200));
+    TEST_ASSERT_EQUAL_UINT16(1023, feed(df2, static_cast<uint16_t>(1023), 200));
+    TEST_ASSERT_EQUAL_UINT16(1, feed(df1, static_cast<uint16_t>(1), 200));
+    TEST_ASSERT_EQUAL_UINT16(1, feed(df2, static_cast<uint16_t>(1), 200));
+    TEST_ASSERT_EQUAL_UINT16(517, feed(df1, static_cast<uint16_t>(517), 200));
+
+    // resonant filter undershoots below 0 after a step down, the output must clamp instead of wrapping
+    BiquadFilter<uint16_t> resonant(biquadLowPass<int16_t>(20, 4, 10000));
+    feed(resonant, static_cast<uint16_t>(1023), 300);
+    bool clamped = false;
+    for (uint16_t i = 0; i < 300; ++i)
+    {
+        resonant.addSample(0);
+        TEST_ASSERT_LESS_THAN(2048, resonant.getFiltered());
+        clamped |= resonant.getFiltered() == 0;
+    }
+    TEST_ASSERT_TRUE(clamped);
+    TEST_ASSERT_EQUAL_UINT16(0, resonant.getFiltered());
+}
+
+int runUnityTests(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_exponential_matches_formula);
+    RUN_TEST(test_average_settles);
+    RUN_TEST(test_average_matches_naive_sum);
+    RUN_TEST(test_average_signed_rounds_toward_zero);
+    RUN_TEST(test_chain_matches_stages);
+    RUN_TEST(test_precise_exponential_settles);
+    RUN_TEST(test_precise_exponential_matches_reference);
+    RUN_TEST(test_median_matches_sort);
+    RUN_TEST(test_median_rejects_spikes);
+    RUN_TEST(test_filter_bank_matches_chains);
+    RUN_TEST(test_biquad_design);
+    RUN_TEST(test_biquad_frequency_response);
+    RUN_TEST(test_biquad_settles_and_saturates);
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup()
+{
+    runUnityTests();
+}
+
+void loop()
+{
+    // not used
+}
+#else
+int main(void)
+{
+    return runUnityTests();
+}
+#endif